@@ -0,0 +1,464 @@
+// Copyright 2021 fpwong. All Rights Reserved.
+
+#include "BAFormatterBenchmarkCommandlet.h"
+
+#include "BlueprintAssistGlobals.h"
+#include "BlueprintAssistGraphHandler.h"
+#include "BlueprintAssistSettings.h"
+#include "BlueprintAssistSizeCache.h"
+#include "EdGraphNode_Comment.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CustomEvent.h"
+#include "BlueprintAssist/GraphFormatters/BAFormatterTimings.h"
+#include "BlueprintAssist/GraphFormatters/EdGraphFormatter.h"
+#include "BlueprintAssist/GraphFormatters/SimpleFormatter.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Actor.h"
+#include "Kismet/KismetStringLibrary.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace BAFormatterBenchmark
+{
+	const FName Shape_Chain("Chain");
+	const FName Shape_Fan("Fan");
+	const FName Shape_Comments("Comments");
+
+	const FName Formatter_Blueprint("Blueprint");
+	const FName Formatter_Simple("Simple");
+
+	const FName Phase_Total("Total");
+
+	/* Fixed node sizes, roughly matching a default editor style */
+	constexpr float NodeWidth = 240.0f;
+	constexpr float NodeHeaderHeight = 32.0f;
+	constexpr float PinRowHeight = 26.0f;
+	constexpr float NodeFooterHeight = 12.0f;
+
+	constexpr int32 RandomSeed = 1234;
+
+	struct FBenchmarkGraph
+	{
+		UEdGraph* Graph = nullptr;
+		UEdGraphNode* RootNode = nullptr;
+		TArray<UEdGraphNode*> ExecNodes;
+		int32 NumNodes = 0;
+		int32 NumComments = 0;
+	};
+
+	struct FBenchmarkConfig
+	{
+		int32 FanWidth = 8;
+		int32 CommentGroup = 5;
+	};
+
+	TArray<FString> ParseList(const FString& Params, const TCHAR* Key, const FString& Default)
+	{
+		FString Value = Default;
+		FParse::Value(*Params, Key, Value);
+
+		TArray<FString> Out;
+		Value.ParseIntoArray(Out, TEXT(","));
+		return Out;
+	}
+
+	UEdGraphPin* FindExecPin(UEdGraphNode* Node, EEdGraphPinDirection Direction)
+	{
+		return Node->FindPin(Direction == EGPD_Input ? UEdGraphSchema_K2::PN_Execute : UEdGraphSchema_K2::PN_Then, Direction);
+	}
+
+	UK2Node_CallFunction* MakeCallFunction(UEdGraph* Graph, UFunction* Function)
+	{
+		FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(*Graph);
+		UK2Node_CallFunction* Node = NodeCreator.CreateNode(false);
+		Node->SetFromFunction(Function);
+		NodeCreator.Finalize();
+		return Node;
+	}
+
+	UEdGraphNode* MakeEvent(UEdGraph* Graph)
+	{
+		FGraphNodeCreator<UK2Node_CustomEvent> NodeCreator(*Graph);
+		UK2Node_CustomEvent* Node = NodeCreator.CreateNode(false);
+		Node->CustomFunctionName = FName("BenchmarkEvent");
+		NodeCreator.Finalize();
+		return Node;
+	}
+
+	UEdGraphNode_Comment* MakeComment(UEdGraph* Graph, const TArray<UEdGraphNode*>& Nodes, FBACacheData& CacheData)
+	{
+		FGraphNodeCreator<UEdGraphNode_Comment> NodeCreator(*Graph);
+		UEdGraphNode_Comment* Comment = NodeCreator.CreateNode(false);
+		NodeCreator.Finalize();
+
+		TOptional<FSlateRect> Bounds;
+		for (UEdGraphNode* Node : Nodes)
+		{
+			FVector2D Size(Node->NodeWidth, Node->NodeHeight);
+			if (FBANodeData* NodeData = CacheData.CachedNodes.Find(Node->NodeGuid))
+			{
+				Size = NodeData->CachedNodeSize;
+			}
+
+			const FSlateRect NodeBounds = FSlateRect::FromPointAndExtent(FVector2D(Node->NodePosX, Node->NodePosY), Size);
+			Bounds = Bounds.IsSet() ? Bounds.GetValue().Expand(NodeBounds) : NodeBounds;
+
+			Comment->AddNodeUnderComment(Node);
+		}
+
+		const FSlateRect CommentBounds = Bounds.Get(FSlateRect()).ExtendBy(FMargin(30.0f, 60.0f, 30.0f, 30.0f));
+		Comment->NodePosX = FMath::RoundToInt(CommentBounds.Left);
+		Comment->NodePosY = FMath::RoundToInt(CommentBounds.Top);
+		Comment->NodeWidth = FMath::RoundToInt(CommentBounds.GetSize().X);
+		Comment->NodeHeight = FMath::RoundToInt(CommentBounds.GetSize().Y);
+		return Comment;
+	}
+
+	/* Give the node a fixed size and pin offsets in the size cache, so formatting does not need the node widgets */
+	void CacheFixedNodeSize(UEdGraphNode* Node, FBACacheData& CacheData)
+	{
+		FBANodeData& NodeData = CacheData.CachedNodes.Add(Node->NodeGuid);
+
+		int32 NumInputs = 0;
+		int32 NumOutputs = 0;
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->bHidden)
+			{
+				continue;
+			}
+
+			int32& Row = Pin->Direction == EGPD_Input ? NumInputs : NumOutputs;
+			NodeData.CachedPins.Add(Pin->PinId, NodeHeaderHeight + (Row + 0.5f) * PinRowHeight);
+			++Row;
+		}
+
+		NodeData.CachedNodeSize = FVector2D(NodeWidth, NodeHeaderHeight + FMath::Max(NumInputs, NumOutputs) * PinRowHeight + NodeFooterHeight);
+	}
+
+	/* Build a binary tree of pure nodes with the given number of unlinked inputs at its ends, returns the root's output pin */
+	UEdGraphPin* MakeConcatTree(FBenchmarkGraph& Out, int32 NumInputs, int32 MaxNodes)
+	{
+		if (NumInputs <= 1 || Out.NumNodes >= MaxNodes)
+		{
+			return nullptr;
+		}
+
+		UFunction* Concat = UKismetStringLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetStringLibrary, Concat_StrStr));
+		UK2Node_CallFunction* Node = MakeCallFunction(Out.Graph, Concat);
+		++Out.NumNodes;
+
+		const int32 NumLeft = NumInputs / 2;
+		if (UEdGraphPin* Left = MakeConcatTree(Out, NumLeft, MaxNodes))
+		{
+			Left->MakeLinkTo(Node->FindPinChecked(TEXT("A")));
+		}
+
+		if (UEdGraphPin* Right = MakeConcatTree(Out, NumInputs - NumLeft, MaxNodes))
+		{
+			Right->MakeLinkTo(Node->FindPinChecked(TEXT("B")));
+		}
+
+		return Node->GetReturnValuePin();
+	}
+
+	void MakeGraphNodes(FName Shape, int32 NumNodes, const FBenchmarkConfig& Config, FBenchmarkGraph& Out)
+	{
+		UFunction* PrintString = UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, PrintString));
+
+		Out.RootNode = MakeEvent(Out.Graph);
+		Out.ExecNodes.Add(Out.RootNode);
+		++Out.NumNodes;
+
+		UEdGraphNode* LastNode = Out.RootNode;
+		while (Out.NumNodes < NumNodes)
+		{
+			UK2Node_CallFunction* Node = MakeCallFunction(Out.Graph, PrintString);
+			++Out.NumNodes;
+
+			FindExecPin(LastNode, EGPD_Output)->MakeLinkTo(FindExecPin(Node, EGPD_Input));
+			Out.ExecNodes.Add(Node);
+			LastNode = Node;
+
+			if (Shape == Shape_Fan)
+			{
+				if (UEdGraphPin* TreeOutput = MakeConcatTree(Out, Config.FanWidth, NumNodes))
+				{
+					TreeOutput->MakeLinkTo(Node->FindPinChecked(TEXT("InString")));
+				}
+			}
+		}
+	}
+
+	/* Scatter the nodes around their order in the exec chain, so the formatter has to move every node */
+	void ScatterNodes(FBenchmarkGraph& Out)
+	{
+		FRandomStream Random(RandomSeed);
+
+		int32 Index = 0;
+		for (UEdGraphNode* Node : Out.Graph->Nodes)
+		{
+			Node->NodePosX = Index * 150 + Random.RandRange(-400, 400);
+			Node->NodePosY = Random.RandRange(-800, 800);
+			++Index;
+		}
+	}
+
+	void MakeComments(const FBenchmarkConfig& Config, FBACacheData& CacheData, FBenchmarkGraph& Out)
+	{
+		const int32 GroupSize = FMath::Max(1, Config.CommentGroup);
+
+		TArray<UEdGraphNode*> InnerComments;
+		TArray<UEdGraphNode*> OuterNodes;
+		for (int32 Start = 0; Start < Out.ExecNodes.Num(); Start += GroupSize)
+		{
+			TArray<UEdGraphNode*> Group;
+			for (int32 i = Start; i < FMath::Min(Start + GroupSize, Out.ExecNodes.Num()); ++i)
+			{
+				Group.Add(Out.ExecNodes[i]);
+			}
+
+			UEdGraphNode_Comment* Comment = MakeComment(Out.Graph, Group, CacheData);
+			++Out.NumComments;
+
+			InnerComments.Add(Comment);
+			OuterNodes.Append(Group);
+
+			// nest every two comments in an outer comment
+			if (InnerComments.Num() == 2)
+			{
+				OuterNodes.Append(InnerComments);
+				MakeComment(Out.Graph, OuterNodes, CacheData);
+				++Out.NumComments;
+
+				InnerComments.Reset();
+				OuterNodes.Reset();
+			}
+		}
+	}
+
+	FBenchmarkGraph MakeGraph(UBlueprint* Blueprint, FName Shape, int32 NumNodes, const FBenchmarkConfig& Config)
+	{
+		FBenchmarkGraph Out;
+
+		const FName GraphName = MakeUniqueObjectName(Blueprint, UEdGraph::StaticClass(), FName("BenchmarkGraph"));
+		Out.Graph = FBlueprintEditorUtils::CreateNewGraph(Blueprint, GraphName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+		Blueprint->UbergraphPages.Add(Out.Graph);
+
+		MakeGraphNodes(Shape, NumNodes, Config, Out);
+
+		ScatterNodes(Out);
+
+		FBACacheData& CacheData = FBASizeCache::Get().GetGraphData(Out.Graph);
+		for (UEdGraphNode* Node : Out.Graph->Nodes)
+		{
+			CacheFixedNodeSize(Node, CacheData);
+		}
+
+		if (Shape == Shape_Comments)
+		{
+			MakeComments(Config, CacheData, Out);
+		}
+
+		return Out;
+	}
+
+	void DestroyGraph(UBlueprint* Blueprint, FBenchmarkGraph& Graph)
+	{
+		if (FBAGraphData* PackageCache = FBASizeCache::Get().GetPackageData().PackageCache.Find(Graph.Graph->GetOutermost()->GetFName()))
+		{
+			PackageCache->GraphCache.Remove(Graph.Graph->GraphGuid);
+		}
+
+		Blueprint->UbergraphPages.Remove(Graph.Graph);
+		Graph.Graph->MarkPendingKill();
+		Graph.Graph = nullptr;
+	}
+
+	TSharedPtr<FFormatterInterface> MakeFormatter(FName FormatterName, TSharedPtr<FBAGraphHandler> GraphHandler)
+	{
+		if (FormatterName == Formatter_Blueprint)
+		{
+			return MakeShared<FEdGraphFormatter>(GraphHandler, FEdGraphFormatterParameters());
+		}
+
+		if (FormatterName == Formatter_Simple)
+		{
+			return MakeShared<FSimpleFormatter>(GraphHandler);
+		}
+
+		return nullptr;
+	}
+}
+
+UBAFormatterBenchmarkCommandlet::UBAFormatterBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UBAFormatterBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace BAFormatterBenchmark;
+
+	TArray<FName> Shapes;
+	for (const FString& ShapeString : ParseList(Params, TEXT("Shapes="), TEXT("Chain,Fan,Comments")))
+	{
+		const FName Shape(*ShapeString);
+		if (Shape == Shape_Chain || Shape == Shape_Fan || Shape == Shape_Comments)
+		{
+			Shapes.Add(Shape);
+		}
+		else
+		{
+			UE_LOG(LogBlueprintAssist, Warning, TEXT("FormatterBenchmark: Unknown shape %s"), *ShapeString);
+		}
+	}
+
+	TArray<int32> Sizes;
+	for (const FString& Size : ParseList(Params, TEXT("Sizes="), TEXT("50,200,1000")))
+	{
+		Sizes.Add(FMath::Max(1, FCString::Atoi(*Size)));
+	}
+
+	TArray<FName> Formatters;
+	for (const FString& FormatterString : ParseList(Params, TEXT("Formatters="), TEXT("Blueprint,Simple")))
+	{
+		const FName Formatter(*FormatterString);
+		if (Formatter == Formatter_Blueprint || Formatter == Formatter_Simple)
+		{
+			Formatters.Add(Formatter);
+		}
+		else
+		{
+			UE_LOG(LogBlueprintAssist, Warning, TEXT("FormatterBenchmark: Unknown formatter %s"), *FormatterString);
+		}
+	}
+
+	int32 Iterations = 3;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	Iterations = FMath::Max(1, Iterations);
+
+	FBenchmarkConfig Config;
+	FParse::Value(*Params, TEXT("FanWidth="), Config.FanWidth);
+	FParse::Value(*Params, TEXT("CommentGroup="), Config.CommentGroup);
+
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("BlueprintAssist") / TEXT("FormatterBenchmark.csv");
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	const bool bCountAllocations = !FParse::Param(*Params, TEXT("NoAllocations"));
+
+	// (bCreateKnotNodes, bApplyCommentPadding)
+	UBASettings* BASettings = GetMutableDefault<UBASettings>();
+	const TPair<bool, bool> SavedSettings(BASettings->bCreateKnotNodes, BASettings->bApplyCommentPadding);
+
+	TArray<TPair<bool, bool>> SettingsToRun = { SavedSettings };
+	if (FParse::Param(*Params, TEXT("CompareSettings")))
+	{
+		SettingsToRun = { { true, true }, { true, false }, { false, true }, { false, false } };
+	}
+
+	UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(
+		AActor::StaticClass(),
+		GetTransientPackage(),
+		MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), FName("BAFormatterBenchmark")),
+		BPTYPE_Normal,
+		UBlueprint::StaticClass(),
+		UBlueprintGeneratedClass::StaticClass());
+
+	if (!Blueprint)
+	{
+		UE_LOG(LogBlueprintAssist, Error, TEXT("FormatterBenchmark: Failed to create blueprint"));
+		return 1;
+	}
+
+	Blueprint->AddToRoot();
+
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Shape,Nodes,Comments,Formatter,CreateKnotNodes,ApplyCommentPadding,Iteration,Phase,Milliseconds,Allocations"));
+
+	for (FName Shape : Shapes)
+	{
+		for (int32 Size : Sizes)
+		{
+			for (const TPair<bool, bool>& Settings : SettingsToRun)
+			{
+				BASettings->bCreateKnotNodes = Settings.Key;
+				BASettings->bApplyCommentPadding = Settings.Value;
+
+				for (FName FormatterName : Formatters)
+				{
+					double TotalMs = 0.0;
+
+					for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+					{
+						FBenchmarkGraph Graph = MakeGraph(Blueprint, Shape, Size, Config);
+
+						TSharedPtr<FBAGraphHandler> GraphHandler = MakeShared<FBAGraphHandler>(Graph.Graph);
+						TSharedPtr<FFormatterInterface> Formatter = MakeFormatter(FormatterName, GraphHandler);
+
+						FBAFormatterTimings::BeginRecording(bCountAllocations);
+						const uint64 StartAllocations = FBAFormatterTimings::GetAllocationCount();
+						const double StartTime = FPlatformTime::Seconds();
+
+						Formatter->FormatNode(Graph.RootNode);
+
+						const double Seconds = FPlatformTime::Seconds() - StartTime;
+						const uint64 Allocations = FBAFormatterTimings::GetAllocationCount() - StartAllocations;
+
+						TMap<FName, FBAFormatterPhaseStats> PhaseStats = FBAFormatterTimings::EndRecording();
+						PhaseStats.Add(Phase_Total, FBAFormatterPhaseStats{ Seconds, Allocations });
+
+						for (const auto& Kvp : PhaseStats)
+						{
+							Lines.Add(FString::Printf(TEXT("%s,%d,%d,%s,%d,%d,%d,%s,%.4f,%s"),
+								*Shape.ToString(),
+								Graph.NumNodes,
+								Graph.NumComments,
+								*FormatterName.ToString(),
+								Settings.Key ? 1 : 0,
+								Settings.Value ? 1 : 0,
+								Iteration,
+								*Kvp.Key.ToString(),
+								Kvp.Value.Seconds * 1000.0,
+								bCountAllocations ? *FString::Printf(TEXT("%llu"), Kvp.Value.Allocations) : TEXT("")));
+						}
+
+						TotalMs += Seconds * 1000.0;
+
+						Formatter.Reset();
+						GraphHandler.Reset();
+						DestroyGraph(Blueprint, Graph);
+					}
+
+					UE_LOG(LogBlueprintAssist, Display, TEXT("FormatterBenchmark: %s %d nodes | %s | Knots %d Padding %d | %.2fms average"),
+						*Shape.ToString(), Size, *FormatterName.ToString(), Settings.Key ? 1 : 0, Settings.Value ? 1 : 0, TotalMs / Iterations);
+				}
+			}
+
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	BASettings->bCreateKnotNodes = SavedSettings.Key;
+	BASettings->bApplyCommentPadding = SavedSettings.Value;
+
+	Blueprint->RemoveFromRoot();
+
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *OutputPath))
+	{
+		UE_LOG(LogBlueprintAssist, Error, TEXT("FormatterBenchmark: Failed to write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogBlueprintAssist, Display, TEXT("FormatterBenchmark: Wrote %d rows to %s"), Lines.Num() - 1, *OutputPath);
+	return 0;
+}
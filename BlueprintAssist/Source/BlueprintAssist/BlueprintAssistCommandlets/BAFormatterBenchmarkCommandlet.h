@@ -0,0 +1,36 @@
+// Copyright 2021 fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Commandlets/Commandlet.h"
+
+#include "BAFormatterBenchmarkCommandlet.generated.h"
+
+/**
+ * Formats synthetic blueprint graphs using fixed node sizes and writes the time and allocation count of each formatter phase as csv.
+ * Does not need an editor window, e.g.
+ *
+ *	UE4Editor-Cmd <Project> -run=BAFormatterBenchmark -nullrhi -unattended -Shapes=Chain,Fan,Comments -Sizes=50,200,1000
+ *
+ * -Shapes			Chain (exec chain), Fan (exec chain with a tree of pure nodes on each node) or Comments (exec chain under nested comments)
+ * -Sizes			Number of graph nodes (excluding comments) in each generated graph
+ * -Formatters		Blueprint and / or Simple
+ * -Iterations		Number of times each graph is generated and formatted
+ * -FanWidth		Number of unlinked inputs at the end of each pure node tree for the Fan shape
+ * -CommentGroup	Number of nodes under each comment for the Comments shape, every two comments are nested in another comment
+ * -CompareSettings	Run each graph with knot nodes and comment padding toggled on and off
+ * -NoAllocations	Don't count allocations (GMalloc is wrapped while formatting to count them)
+ * -Output			Path of the csv file, defaults to <ProjectSaved>/BlueprintAssist/FormatterBenchmark.csv
+ */
+UCLASS()
+class UBAFormatterBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBAFormatterBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
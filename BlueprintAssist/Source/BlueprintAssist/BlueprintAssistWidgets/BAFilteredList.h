@@ -58,6 +58,14 @@ private:
 	FBAOnMarkActiveSuggestion OnMarkActiveSuggestion;
 	FText FilterText;
 
+	/** Lower case search texts, built once for each item in AllItems */
+	TArray<FString> SearchKeys;
+	TArray<FString> KeySearchKeys;
+
+	/** Terms and matching item indices of the last filter, used to narrow the search when the filter is extended */
+	TArray<FString> LastFilterTerms;
+	TArray<int32> LastMatchingIndices;
+
 public:
 	void Construct(const FArguments& InArgs)
 	{
@@ -71,6 +79,8 @@ public:
 
 		InArgs._InitListItems.Execute(AllItems);
 
+		BuildSearchIndex();
+
 		FilteredItems = AllItems;
 
 		RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateSP(this, &SBAFilteredList::SetFocusPostConstruct));
@@ -158,13 +168,26 @@ public:
 		);
 	}
 
+	void BuildSearchIndex()
+	{
+		SearchKeys.Reset(AllItems.Num());
+		KeySearchKeys.Reset(AllItems.Num());
+		for (const ItemType& Item : AllItems)
+		{
+			SearchKeys.Add(Item->GetSearchText().ToLower());
+			KeySearchKeys.Add(Item->GetKeySearchText().ToLower());
+		}
+
+		LastFilterTerms.Reset();
+		LastMatchingIndices.Reset();
+	}
+
 	void OnFilterTextChanged(const FText& InFilterText)
 	{
 		FilterText = InFilterText;
-		FString FilterString = InFilterText.ToString();
 
 		// Trim and sanitized the filter text (so that it more likely matches the action descriptions)
-		const FString TrimmedFilterString = FText::TrimPrecedingAndTrailing(InFilterText).ToString();
+		const FString TrimmedFilterString = FText::TrimPrecedingAndTrailing(InFilterText).ToString().ToLower();
 
 		// Tokenize the search box text into a set of terms; all of them must be present to pass the filter
 		TArray<FString> FilterTerms;
@@ -172,47 +195,59 @@ public:
 
 		FilteredItems.Empty();
 
-		const bool bRequiresFiltering = FilterTerms.Num() > 0;
-		for (int32 ItemIndex = 0; ItemIndex < AllItems.Num(); ++ItemIndex)
+		if (FilterTerms.Num() == 0)
 		{
-			ItemType Item = AllItems[ItemIndex];
-
-			// If we're filtering, search check to see if we need to show this action
-			bool bShowAction = true;
-			if (bRequiresFiltering)
+			FilteredItems = AllItems;
+			LastFilterTerms.Reset();
+			LastMatchingIndices.Reset();
+		}
+		else
+		{
+			// Items which failed the previous filter can't pass a filter which only extended its terms
+			TArray<int32> MatchingIndices;
+			if (IsFilterExtended(FilterTerms))
 			{
-				const FString& SearchText = Item->GetSearchText();
-
-				FString EachTermSanitized;
-				for (int32 FilterIndex = 0; FilterIndex < FilterTerms.Num() && bShowAction; ++FilterIndex)
+				MatchingIndices.Reserve(LastMatchingIndices.Num());
+				for (int32 ItemIndex : LastMatchingIndices)
+				{
+					if (MatchesTerms(ItemIndex, FilterTerms))
+					{
+						MatchingIndices.Add(ItemIndex);
+					}
+				}
+			}
+			else
+			{
+				for (int32 ItemIndex = 0; ItemIndex < AllItems.Num(); ++ItemIndex)
 				{
-					const bool bMatchesTerm = SearchText.Contains(FilterTerms[FilterIndex]);
-					bShowAction = bShowAction && bMatchesTerm;
+					if (MatchesTerms(ItemIndex, FilterTerms))
+					{
+						MatchingIndices.Add(ItemIndex);
+					}
 				}
 			}
 
-			if (bShowAction)
+			// Score each item once, ties keep the original item order
+			TArray<TPair<int32, int32>> ScoredIndices;
+			ScoredIndices.Reserve(MatchingIndices.Num());
+			for (int32 ItemIndex : MatchingIndices)
 			{
-				FilteredItems.Add(Item);
+				ScoredIndices.Emplace(GetFuzzyScore(KeySearchKeys[ItemIndex], TrimmedFilterString), ItemIndex);
 			}
-		}
 
-		if (!TrimmedFilterString.IsEmpty())
-		{
-			FilteredItems.StableSort([&FilterString](const ItemType ItemA, const ItemType ItemB)
+			ScoredIndices.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
 			{
-				if (FilterString.Equals(ItemA->GetKeySearchText(), ESearchCase::IgnoreCase))
-				{
-					return true;
-				}
+				return A.Key != B.Key ? A.Key > B.Key : A.Value < B.Value;
+			});
 
-				if (FilterString.Equals(ItemB->GetKeySearchText(), ESearchCase::IgnoreCase))
-				{
-					return false;
-				}
+			FilteredItems.Reserve(ScoredIndices.Num());
+			for (const TPair<int32, int32>& ScoredIndex : ScoredIndices)
+			{
+				FilteredItems.Add(AllItems[ScoredIndex.Value]);
+			}
 
-				return ItemA->GetKeySearchText().Len() < ItemB->GetKeySearchText().Len();
-			});
+			LastFilterTerms = MoveTemp(FilterTerms);
+			LastMatchingIndices = MoveTemp(MatchingIndices);
 		}
 
 		FilteredItemsListView->RequestListRefresh();
@@ -229,6 +264,130 @@ public:
 		}
 	}
 
+	/** An item passes if each term is in its search text, or the term's characters appear in order in its key search text */
+	bool MatchesTerms(int32 ItemIndex, const TArray<FString>& Terms) const
+	{
+		for (const FString& Term : Terms)
+		{
+			if (!SearchKeys[ItemIndex].Contains(Term, ESearchCase::CaseSensitive) && !IsSubsequence(KeySearchKeys[ItemIndex], Term))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** True if every previous term is contained in one of the new terms, so anything matching the new terms matched the old ones */
+	bool IsFilterExtended(const TArray<FString>& Terms) const
+	{
+		if (LastFilterTerms.Num() == 0)
+		{
+			return false;
+		}
+
+		for (const FString& LastTerm : LastFilterTerms)
+		{
+			const bool bExtended = Terms.ContainsByPredicate([&LastTerm](const FString& Term)
+			{
+				return Term.Contains(LastTerm, ESearchCase::CaseSensitive);
+			});
+
+			if (!bExtended)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static bool IsSubsequence(const FString& Text, const FString& Term)
+	{
+		int32 TermIndex = 0;
+		for (int32 i = 0; i < Text.Len() && TermIndex < Term.Len(); ++i)
+		{
+			if (Text[i] == Term[TermIndex])
+			{
+				++TermIndex;
+			}
+		}
+
+		return TermIndex == Term.Len();
+	}
+
+	static bool IsWordStart(const FString& Text, int32 Index)
+	{
+		return Index == 0 || !FChar::IsAlnum(Text[Index - 1]);
+	}
+
+	/**
+	 * Rank the key search text against the filter: exact match, then prefix, then substring (earlier is better),
+	 * then in-order character matches which favour consecutive characters and the start of words.
+	 * Shorter texts rank higher within each group.
+	 */
+	static int32 GetFuzzyScore(const FString& Key, const FString& Filter)
+	{
+		if (Key.Equals(Filter, ESearchCase::CaseSensitive))
+		{
+			return MAX_int32;
+		}
+
+		const int32 LengthPenalty = FMath::Min(Key.Len(), 1000);
+
+		const int32 FoundIndex = Key.Find(Filter, ESearchCase::CaseSensitive);
+		if (FoundIndex == 0)
+		{
+			return 3000000 - LengthPenalty;
+		}
+
+		if (FoundIndex != INDEX_NONE)
+		{
+			const int32 WordStartBonus = IsWordStart(Key, FoundIndex) ? 500000 : 0;
+			return 2000000 + WordStartBonus - FMath::Min(FoundIndex, 1000) * 100 - LengthPenalty;
+		}
+
+		int32 Score = 0;
+		int32 KeyIndex = 0;
+		int32 LastMatchIndex = INDEX_NONE;
+		for (int32 FilterIndex = 0; FilterIndex < Filter.Len(); ++FilterIndex)
+		{
+			const TCHAR FilterChar = Filter[FilterIndex];
+			if (FChar::IsWhitespace(FilterChar))
+			{
+				continue;
+			}
+
+			while (KeyIndex < Key.Len() && Key[KeyIndex] != FilterChar)
+			{
+				++KeyIndex;
+			}
+
+			if (KeyIndex >= Key.Len())
+			{
+				// no in-order match, only the search text matched
+				return -LengthPenalty;
+			}
+
+			Score += 10;
+
+			if (LastMatchIndex != INDEX_NONE && KeyIndex == LastMatchIndex + 1)
+			{
+				Score += 15;
+			}
+
+			if (IsWordStart(Key, KeyIndex))
+			{
+				Score += 20;
+			}
+
+			LastMatchIndex = KeyIndex;
+			++KeyIndex;
+		}
+
+		return 1000000 + FMath::Min(Score, 999) * 1000 - LengthPenalty;
+	}
+
 	void OnFilterTextCommitted(const FText& InText, ETextCommit::Type CommitInfo)
 	{
 		if (CommitInfo == ETextCommit::OnEnter)
@@ -2,6 +2,7 @@
 
 #include "GoToSymbolMenu.h"
 
+#include "BlueprintAssistAssetEditorHandler.h"
 #include "BlueprintAssistGraphHandler.h"
 #include "BlueprintAssistUtils.h"
 #include "BlueprintEditor.h"
@@ -32,54 +33,66 @@ void SGoToSymbolMenu::InitListItems(TArray<TSharedPtr<FGoToSymbolStruct>>& Items
 	UBlueprint* Blueprint = FBAUtils::GetAssetForActiveTab<UBlueprint>();
 	check(Blueprint)
 
+	Items.Empty();
+
+	// the blueprint handler keeps the symbols of open blueprints up to date
+	if (FBABlueprintHandler* BlueprintHandler = FBAAssetEditorHandler::Get().GetBlueprintHandler(Blueprint))
+	{
+		Items = BlueprintHandler->GetSymbols();
+		return;
+	}
+
 	TArray<UEdGraph*> BlueprintGraphs;
 	Blueprint->GetAllGraphs(BlueprintGraphs);
 
-	Items.Empty();
-
 	for (UEdGraph* Graph : BlueprintGraphs)
 	{
-		const EGraphType GraphType = FBAUtils::GetGraphType(Graph);
-
 		if (Blueprint->DelegateSignatureGraphs.Contains(Graph))
 		{
 			continue;
 		}
 
-		// add all event nodes on the graph for ubergraphs
-		if (GraphType == GT_Ubergraph)
-		{
-			TArray<UEdGraphNode*> EventNodes;
-			Graph->GetNodesOfClass(EventNodes);
+		GetGraphSymbols(Graph, Items);
+	}
+}
+
+void SGoToSymbolMenu::GetGraphSymbols(UEdGraph* Graph, TArray<TSharedPtr<FGoToSymbolStruct>>& OutSymbols)
+{
+	const EGraphType GraphType = FBAUtils::GetGraphType(Graph);
 
-			EventNodes = EventNodes.FilterByPredicate(
-				[](UEdGraphNode* Node)
-				{
-					return Node->GetClass()->ImplementsInterface(UK2Node_EventNodeInterface::StaticClass());
-				});
+	// add all event nodes on the graph for ubergraphs
+	if (GraphType == GT_Ubergraph)
+	{
+		TArray<UEdGraphNode*> EventNodes;
+		Graph->GetNodesOfClass(EventNodes);
 
-			EventNodes.Sort([](const UEdGraphNode& NodeA, const UEdGraphNode& NodeB)
+		EventNodes = EventNodes.FilterByPredicate(
+			[](UEdGraphNode* Node)
 			{
-				const bool bIsEventA = NodeA.GetClass() == UK2Node_Event::StaticClass();
-				const bool bIsEventB = NodeB.GetClass() == UK2Node_Event::StaticClass();
-				if (bIsEventA != bIsEventB) return bIsEventA > bIsEventB;
+				return Node->GetClass()->ImplementsInterface(UK2Node_EventNodeInterface::StaticClass());
+			});
 
-				const bool bIsCustomEventA = NodeA.GetClass() == UK2Node_CustomEvent::StaticClass();
-				const bool bIsCustomEventB = NodeB.GetClass() == UK2Node_CustomEvent::StaticClass();
-				if (bIsCustomEventA != bIsCustomEventB) return bIsCustomEventA > bIsCustomEventB;
+		EventNodes.Sort([](const UEdGraphNode& NodeA, const UEdGraphNode& NodeB)
+		{
+			const bool bIsEventA = NodeA.GetClass() == UK2Node_Event::StaticClass();
+			const bool bIsEventB = NodeB.GetClass() == UK2Node_Event::StaticClass();
+			if (bIsEventA != bIsEventB) return bIsEventA > bIsEventB;
 
-				return true;
-			});
+			const bool bIsCustomEventA = NodeA.GetClass() == UK2Node_CustomEvent::StaticClass();
+			const bool bIsCustomEventB = NodeB.GetClass() == UK2Node_CustomEvent::StaticClass();
+			if (bIsCustomEventA != bIsCustomEventB) return bIsCustomEventA > bIsCustomEventB;
 
-			for (UEdGraphNode* Node : EventNodes)
-			{
-				Items.Add(MakeShareable(new FGoToSymbolStruct(Node, Graph)));
-			}
-		}
+			return true;
+		});
 
-		// add the graph itself
-		Items.Add(MakeShareable(new FGoToSymbolStruct(nullptr, Graph)));
+		for (UEdGraphNode* Node : EventNodes)
+		{
+			OutSymbols.Add(MakeShareable(new FGoToSymbolStruct(Node, Graph)));
+		}
 	}
+
+	// add the graph itself
+	OutSymbols.Add(MakeShareable(new FGoToSymbolStruct(nullptr, Graph)));
 }
 
 TSharedRef<ITableRow> SGoToSymbolMenu::CreateItemWidget(TSharedPtr<FGoToSymbolStruct> Item, const TSharedRef<STableViewBase>& OwnerTable) const
@@ -39,6 +39,9 @@ class BLUEPRINTASSIST_API SGoToSymbolMenu final : public SBorder
 
 	void InitListItems(TArray<TSharedPtr<FGoToSymbolStruct>>& Items);
 
+	/** Collect the symbols for a single graph: its event nodes (for ubergraphs) followed by the graph itself */
+	static void GetGraphSymbols(UEdGraph* Graph, TArray<TSharedPtr<FGoToSymbolStruct>>& OutSymbols);
+
 	TSharedRef<ITableRow> CreateItemWidget(TSharedPtr<FGoToSymbolStruct> Item, const TSharedRef<STableViewBase>& OwnerTable) const;
 
 	void SelectItem(TSharedPtr<FGoToSymbolStruct> Item);
@@ -0,0 +1,119 @@
+// Copyright 2021 fpwong. All Rights Reserved.
+
+#include "BAFormatterTimings.h"
+
+#include "HAL/ThreadSafeCounter64.h"
+
+namespace BAFormatterTimings
+{
+	/* Forwards everything to the wrapped allocator, counting each new allocation */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FMalloc* Inner = nullptr;
+
+		FThreadSafeCounter64 NumAllocations;
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			NumAllocations.Increment();
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (!Original)
+			{
+				NumAllocations.Increment();
+			}
+
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+	};
+
+	/* Never deleted, another thread may still be inside it after GMalloc has been restored */
+	FCountingMalloc* CountingMalloc = nullptr;
+}
+
+TMap<FName, FBAFormatterPhaseStats>* FBAFormatterTimings::ActiveStats = nullptr;
+
+void FBAFormatterTimings::BeginRecording(bool bCountAllocations)
+{
+	check(IsInGameThread());
+
+	EndRecording();
+
+	ActiveStats = new TMap<FName, FBAFormatterPhaseStats>();
+
+	if (bCountAllocations)
+	{
+		using namespace BAFormatterTimings;
+		if (!CountingMalloc)
+		{
+			CountingMalloc = new FCountingMalloc();
+		}
+
+		CountingMalloc->Inner = GMalloc;
+		CountingMalloc->NumAllocations.Reset();
+		GMalloc = CountingMalloc;
+	}
+}
+
+TMap<FName, FBAFormatterPhaseStats> FBAFormatterTimings::EndRecording()
+{
+	using namespace BAFormatterTimings;
+	if (CountingMalloc && GMalloc == CountingMalloc)
+	{
+		GMalloc = CountingMalloc->Inner;
+	}
+
+	TMap<FName, FBAFormatterPhaseStats> Stats;
+	if (ActiveStats)
+	{
+		Stats = MoveTemp(*ActiveStats);
+		delete ActiveStats;
+		ActiveStats = nullptr;
+	}
+
+	return Stats;
+}
+
+uint64 FBAFormatterTimings::GetAllocationCount()
+{
+	using namespace BAFormatterTimings;
+	return CountingMalloc && GMalloc == CountingMalloc ? CountingMalloc->NumAllocations.GetValue() : 0;
+}
+
+void FBAFormatterTimings::AddPhase(FName Phase, double Seconds, uint64 Allocations)
+{
+	if (ActiveStats && IsInGameThread())
+	{
+		FBAFormatterPhaseStats& Stats = ActiveStats->FindOrAdd(Phase);
+		Stats.Seconds += Seconds;
+		Stats.Allocations += Allocations;
+	}
+}
@@ -0,0 +1,65 @@
+// Copyright 2021 fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBAFormatterPhaseStats
+{
+	double Seconds = 0.0;
+
+	uint64 Allocations = 0;
+};
+
+/**
+ * Accumulates the time and number of allocations of each formatter phase while recording (used by the formatter benchmark).
+ * Phases may nest, a nested phase is also counted in the phase containing it.
+ */
+class BLUEPRINTASSIST_API FBAFormatterTimings
+{
+public:
+	/* Start recording, allocations are counted by wrapping GMalloc until the recording ends */
+	static void BeginRecording(bool bCountAllocations);
+
+	static TMap<FName, FBAFormatterPhaseStats> EndRecording();
+
+	static bool IsRecording() { return ActiveStats != nullptr; }
+
+	/* Number of allocations made since the recording began, 0 if allocations are not being counted */
+	static uint64 GetAllocationCount();
+
+	static void AddPhase(FName Phase, double Seconds, uint64 Allocations);
+
+private:
+	static TMap<FName, FBAFormatterPhaseStats>* ActiveStats;
+};
+
+struct BLUEPRINTASSIST_API FBAScopedFormatterPhase
+{
+	explicit FBAScopedFormatterPhase(FName InPhase)
+		: Phase(InPhase)
+		, bRecording(FBAFormatterTimings::IsRecording())
+		, StartTime(bRecording ? FPlatformTime::Seconds() : 0.0)
+		, StartAllocations(bRecording ? FBAFormatterTimings::GetAllocationCount() : 0) { }
+
+	~FBAScopedFormatterPhase()
+	{
+		if (bRecording && FBAFormatterTimings::IsRecording())
+		{
+			FBAFormatterTimings::AddPhase(
+				Phase,
+				FPlatformTime::Seconds() - StartTime,
+				FBAFormatterTimings::GetAllocationCount() - StartAllocations);
+		}
+	}
+
+private:
+	FName Phase;
+	bool bRecording;
+	double StartTime;
+	uint64 StartAllocations;
+};
+
+#define BA_FORMATTER_PHASE(PhaseName) \
+	static const FName PREPROCESSOR_JOIN(BAFormatterPhaseName_, __LINE__)(TEXT(PhaseName)); \
+	FBAScopedFormatterPhase PREPROCESSOR_JOIN(BAFormatterPhase_, __LINE__)(PREPROCESSOR_JOIN(BAFormatterPhaseName_, __LINE__))
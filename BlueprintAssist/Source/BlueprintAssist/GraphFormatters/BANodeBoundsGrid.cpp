@@ -0,0 +1,218 @@
+// Copyright 2021 fpwong. All Rights Reserved.
+
+#include "BANodeBoundsGrid.h"
+
+#include "BlueprintAssistUtils.h"
+#include "Algo/Sort.h"
+
+FBANodeBoundsGrid::FBANodeBoundsGrid(float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.0f))
+	, NextOrder(0) { }
+
+void FBANodeBoundsGrid::Reset()
+{
+	Entries.Reset();
+	Cells.Reset();
+	NextOrder = 0;
+}
+
+void FBANodeBoundsGrid::AddNode(UEdGraphNode* Node, const FSlateRect& Bounds)
+{
+	if (FEntry* Entry = Entries.Find(Node))
+	{
+		RemoveFromCells(Node, Entry->Bounds);
+		Entry->Bounds = Bounds;
+	}
+	else
+	{
+		Entries.Add(Node, FEntry{ Bounds, NextOrder++ });
+	}
+
+	AddToCells(Node, Bounds);
+}
+
+void FBANodeBoundsGrid::UpdateNode(UEdGraphNode* Node, const FSlateRect& Bounds)
+{
+	FEntry* Entry = Entries.Find(Node);
+	if (!Entry)
+	{
+		AddNode(Node, Bounds);
+		return;
+	}
+
+	// only touch the cells if the node moved into a different cell range
+	if (GetCellRange(Entry->Bounds) != GetCellRange(Bounds))
+	{
+		RemoveFromCells(Node, Entry->Bounds);
+		AddToCells(Node, Bounds);
+	}
+
+	Entry->Bounds = Bounds;
+}
+
+void FBANodeBoundsGrid::RemoveNode(UEdGraphNode* Node)
+{
+	FEntry Entry;
+	if (Entries.RemoveAndCopyValue(Node, Entry))
+	{
+		RemoveFromCells(Node, Entry.Bounds);
+	}
+}
+
+void FBANodeBoundsGrid::FindLineIntersections(
+	const FVector2D& Start,
+	const FVector2D& End,
+	const FMargin& Padding,
+	TArray<UEdGraphNode*>& OutNodes) const
+{
+	const FSlateRect LineBounds(
+		FMath::Min(Start.X, End.X),
+		FMath::Min(Start.Y, End.Y),
+		FMath::Max(Start.X, End.X),
+		FMath::Max(Start.Y, End.Y));
+
+	const auto& CellOnLine = [&](const FSlateRect& CellRect)
+	{
+		return FBAUtils::LineRectIntersection(CellRect.ExtendBy(Padding), Start, End);
+	};
+
+	TArray<UEdGraphNode*> Candidates;
+	GatherCandidates(LineBounds.ExtendBy(Padding), CellOnLine, Candidates);
+
+	for (UEdGraphNode* Node : Candidates)
+	{
+		if (FBAUtils::LineRectIntersection(Entries[Node].Bounds.ExtendBy(Padding), Start, End))
+		{
+			OutNodes.Add(Node);
+		}
+	}
+
+	SortByOrder(OutNodes);
+}
+
+bool FBANodeBoundsGrid::AnyLineIntersection(
+	const FVector2D& Start,
+	const FVector2D& End,
+	const FMargin& Padding,
+	const TSet<UEdGraphNode*>& IgnoredNodes) const
+{
+	TArray<UEdGraphNode*> Intersecting;
+	FindLineIntersections(Start, End, Padding, Intersecting);
+
+	for (UEdGraphNode* Node : Intersecting)
+	{
+		if (!IgnoredNodes.Contains(Node))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FBANodeBoundsGrid::FindRectIntersections(const FSlateRect& Rect, TArray<UEdGraphNode*>& OutNodes) const
+{
+	TArray<UEdGraphNode*> Candidates;
+	GatherCandidates(Rect, [](const FSlateRect&) { return true; }, Candidates);
+
+	for (UEdGraphNode* Node : Candidates)
+	{
+		if (FSlateRect::DoRectanglesIntersect(Entries[Node].Bounds, Rect))
+		{
+			OutNodes.Add(Node);
+		}
+	}
+
+	SortByOrder(OutNodes);
+}
+
+FIntRect FBANodeBoundsGrid::GetCellRange(const FSlateRect& Rect) const
+{
+	return FIntRect(
+		FMath::FloorToInt(Rect.Left / CellSize),
+		FMath::FloorToInt(Rect.Top / CellSize),
+		FMath::FloorToInt(Rect.Right / CellSize),
+		FMath::FloorToInt(Rect.Bottom / CellSize));
+}
+
+void FBANodeBoundsGrid::AddToCells(UEdGraphNode* Node, const FSlateRect& Bounds)
+{
+	const FIntRect Range = GetCellRange(Bounds);
+	for (int32 X = Range.Min.X; X <= Range.Max.X; ++X)
+	{
+		for (int32 Y = Range.Min.Y; Y <= Range.Max.Y; ++Y)
+		{
+			Cells.FindOrAdd(FIntPoint(X, Y)).Add(Node);
+		}
+	}
+}
+
+void FBANodeBoundsGrid::RemoveFromCells(UEdGraphNode* Node, const FSlateRect& Bounds)
+{
+	const FIntRect Range = GetCellRange(Bounds);
+	for (int32 X = Range.Min.X; X <= Range.Max.X; ++X)
+	{
+		for (int32 Y = Range.Min.Y; Y <= Range.Max.Y; ++Y)
+		{
+			const FIntPoint Cell(X, Y);
+			if (TArray<UEdGraphNode*>* CellNodes = Cells.Find(Cell))
+			{
+				CellNodes->RemoveSingleSwap(Node, false);
+				if (CellNodes->Num() == 0)
+				{
+					Cells.Remove(Cell);
+				}
+			}
+		}
+	}
+}
+
+void FBANodeBoundsGrid::GatherCandidates(
+	const FSlateRect& Area,
+	TFunctionRef<bool(const FSlateRect&)> CellFilter,
+	TArray<UEdGraphNode*>& OutCandidates) const
+{
+	const FIntRect Range = GetCellRange(Area);
+	const int64 NumCells = int64(Range.Max.X - Range.Min.X + 1) * int64(Range.Max.Y - Range.Min.Y + 1);
+
+	// the area covers more cells than there are nodes, testing every node is cheaper
+	if (NumCells > Entries.Num())
+	{
+		Entries.GetKeys(OutCandidates);
+		return;
+	}
+
+	TSet<UEdGraphNode*> Visited;
+	for (int32 X = Range.Min.X; X <= Range.Max.X; ++X)
+	{
+		for (int32 Y = Range.Min.Y; Y <= Range.Max.Y; ++Y)
+		{
+			const TArray<UEdGraphNode*>* CellNodes = Cells.Find(FIntPoint(X, Y));
+			if (!CellNodes)
+			{
+				continue;
+			}
+
+			const FSlateRect CellRect(X * CellSize, Y * CellSize, (X + 1) * CellSize, (Y + 1) * CellSize);
+			if (!CellFilter(CellRect))
+			{
+				continue;
+			}
+
+			for (UEdGraphNode* Node : *CellNodes)
+			{
+				bool bAlreadyVisited = false;
+				Visited.Add(Node, &bAlreadyVisited);
+				if (!bAlreadyVisited)
+				{
+					OutCandidates.Add(Node);
+				}
+			}
+		}
+	}
+}
+
+void FBANodeBoundsGrid::SortByOrder(TArray<UEdGraphNode*>& Nodes) const
+{
+	Algo::SortBy(Nodes, [this](UEdGraphNode* Node) { return Entries[Node].Order; });
+}
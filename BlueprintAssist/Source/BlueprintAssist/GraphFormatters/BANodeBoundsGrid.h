@@ -0,0 +1,67 @@
+// Copyright 2021 fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Layout/Margin.h"
+#include "Layout/SlateRect.h"
+
+class UEdGraphNode;
+
+/**
+ * Uniform grid of node bounds used by the formatter for collision queries.
+ * Each node is registered in every cell its bounds overlap, so a query only tests the nodes near the queried area.
+ * Query results are returned in the order the nodes were added.
+ */
+class BLUEPRINTASSIST_API FBANodeBoundsGrid
+{
+public:
+	explicit FBANodeBoundsGrid(float InCellSize = 256.0f);
+
+	void Reset();
+
+	bool IsEmpty() const { return Entries.Num() == 0; }
+
+	int32 Num() const { return Entries.Num(); }
+
+	void AddNode(UEdGraphNode* Node, const FSlateRect& Bounds);
+
+	void UpdateNode(UEdGraphNode* Node, const FSlateRect& Bounds);
+
+	void RemoveNode(UEdGraphNode* Node);
+
+	bool Contains(UEdGraphNode* Node) const { return Entries.Contains(Node); }
+
+	/** Find nodes whose bounds (extended by padding) intersect the line segment */
+	void FindLineIntersections(const FVector2D& Start, const FVector2D& End, const FMargin& Padding, TArray<UEdGraphNode*>& OutNodes) const;
+
+	bool AnyLineIntersection(const FVector2D& Start, const FVector2D& End, const FMargin& Padding, const TSet<UEdGraphNode*>& IgnoredNodes) const;
+
+	/** Find nodes whose bounds intersect the rect */
+	void FindRectIntersections(const FSlateRect& Rect, TArray<UEdGraphNode*>& OutNodes) const;
+
+private:
+	struct FEntry
+	{
+		FSlateRect Bounds;
+		int32 Order;
+	};
+
+	FIntRect GetCellRange(const FSlateRect& Rect) const;
+
+	void AddToCells(UEdGraphNode* Node, const FSlateRect& Bounds);
+
+	void RemoveFromCells(UEdGraphNode* Node, const FSlateRect& Bounds);
+
+	/** Gather each node registered in the cells overlapping the area once, skipping cells rejected by the filter */
+	void GatherCandidates(const FSlateRect& Area, TFunctionRef<bool(const FSlateRect&)> CellFilter, TArray<UEdGraphNode*>& OutCandidates) const;
+
+	void SortByOrder(TArray<UEdGraphNode*>& Nodes) const;
+
+	float CellSize;
+	int32 NextOrder;
+
+	TMap<UEdGraphNode*, FEntry> Entries;
+	TMap<FIntPoint, TArray<UEdGraphNode*>> Cells;
+};
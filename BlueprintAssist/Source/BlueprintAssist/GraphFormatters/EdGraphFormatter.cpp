@@ -2,6 +2,7 @@
 
 #include "EdGraphFormatter.h"
 
+#include "BAFormatterTimings.h"
 #include "BlueprintAssistGlobals.h"
 #include "BlueprintAssistGraphHandler.h"
 #include "BlueprintAssistSettings.h"
@@ -15,6 +16,7 @@
 #include "Editor/BlueprintGraph/Classes/K2Node_Knot.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "KnotTrack/KnotTrackCreator.h"
+#include "Misc/ScopeExit.h"
 
 FNodeChangeInfo::FNodeChangeInfo(UEdGraphNode* InNode, UEdGraphNode* InNodeToKeepStill)
 	: Node(InNode)
@@ -131,6 +133,8 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 	CommentHandler.Reset();
 	NodeChangeInfos.Reset();
 	NodePool.Reset();
+	NodePoolSet.Reset();
+	OriginalNodePositions.Reset();
 	MainParameterFormatter.Reset();
 	ParameterFormatterMap.Reset();
 	FormatXInfoMap.Reset();
@@ -143,6 +147,7 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 	if (FBAUtils::GetLinkedPins(RootNode).Num() == 0)
 	{
 		NodePool = { RootNode };
+		NodePoolSet = { RootNode };
 		return;
 	}
 
@@ -158,6 +163,7 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 
 	if (FBAUtils::IsNodePure(RootNode))
 	{
+		RootNode->Modify();
 		MainParameterFormatter = MakeShared<FEdGraphParameterFormatter>(GraphHandler, RootNode, SharedThis(this), NodeToKeepStill);
 		MainParameterFormatter->FormatNode(RootNode);
 		return;
@@ -166,7 +172,17 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 	const FVector2D SavedLocation = FVector2D(NodeToKeepStill->NodePosX, NodeToKeepStill->NodePosY);
 
 	// initialize the node pool from the root node
-	InitNodePool();
+	{
+		BA_FORMATTER_PHASE("InitNodePool");
+		InitNodePool();
+	}
+
+	// pool nodes are only added to the transaction once we know they moved, this must also happen on the debug early outs
+	ON_SCOPE_EXIT
+	{
+		ModifyMovedNodes();
+		OriginalNodePositions.Empty();
+	};
 
 	CommentHandler.Init(GraphHandler, SharedThis(this));
 
@@ -181,9 +197,11 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 	// 	// UE_LOG(LogBlueprintAssist, Warning, TEXT("\t\tNodePool %s"), *FBAUtils::GetNodeName(Node));
 	// }
 
-	GetPinsOfSameHeight();
-
-	FormatX(false);
+	{
+		BA_FORMATTER_PHASE("FormatX");
+		GetPinsOfSameHeight();
+		FormatX(false);
+	}
 
 	//UE_LOG(LogBlueprintAssist, Warning, TEXT("Path: "));
 	//for (FPinLink& PinLink : Path)
@@ -214,7 +232,10 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 	}
 
 	/** Format the input nodes before we format the X position so we can get the column bounds */
-	FormatParameterNodes();
+	{
+		BA_FORMATTER_PHASE("FormatParameterNodes");
+		FormatParameterNodes();
+	}
 
 	CommentHandler.Init(GraphHandler, SharedThis(this));
 
@@ -223,9 +244,12 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 		return;
 	}
 
-	Path.Empty();
-	FormatXInfoMap.Empty();
-	FormatX(true);
+	{
+		BA_FORMATTER_PHASE("FormatX");
+		Path.Empty();
+		FormatXInfoMap.Empty();
+		FormatX(true);
+	}
 
 	// UE_LOG(LogTemp, Warning, TEXT("Same row mapping"));
 	// for (auto Kvp : SameRowMapping)
@@ -245,11 +269,13 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 
 	if (GetDefault<UBASettings>()->bExpandNodesAheadOfParameters)
 	{
+		BA_FORMATTER_PHASE("ExpandNodesAheadOfParameters");
 		ExpandNodesAheadOfParameters();
 	}
 
 	if (GetDefault<UBASettings>()->bApplyCommentPadding)
 	{
+		BA_FORMATTER_PHASE("CommentPadding");
 		ApplyCommentPaddingX();
 	}
 
@@ -259,10 +285,14 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 	}
 
 	/** Format Y (Rows) */
-	FormatY();
+	{
+		BA_FORMATTER_PHASE("FormatY");
+		FormatY();
+	}
 
 	if (GetDefault<UBASettings>()->bApplyCommentPadding)
 	{
+		BA_FORMATTER_PHASE("CommentPadding");
 		ApplyCommentPaddingY();
 	}
 
@@ -273,6 +303,7 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 
 	if (GetMutableDefault<UBASettings>()->bExpandNodesByHeight)
 	{
+		BA_FORMATTER_PHASE("ExpandByHeight");
 		ExpandByHeight();
 	}
 
@@ -282,7 +313,13 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 	/** Format knot nodes */
 	if (GetMutableDefault<UBASettings>()->bCreateKnotNodes)
 	{
+		BA_FORMATTER_PHASE("KnotTracks");
+		BuildNodeBoundsGrid();
+
+		// relinking pins modifies their nodes, record the positions from before formatting first
+		ModifyMovedNodes();
 		KnotTrackCreator.FormatKnotNodes();
+		NodeBoundsGrid.Reset();
 	}
 
 	/** Formatting may move nodes, move all nodes back using the root as a baseline */
@@ -311,7 +348,7 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 	//}
 	//
 
-	if (bAreAllNodesSelected)
+	if (bAreAllNodesSelected && GraphHandler->GetGraphPanel().IsValid())
 	{
 		auto& SelectionManager = GraphHandler->GetGraphPanel()->SelectionManager;
 		for (auto Node : KnotTrackCreator.GetCreatedKnotNodes())
@@ -324,10 +361,13 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 void FEdGraphFormatter::InitNodePool()
 {
 	NodePool.Empty();
+	NodePoolSet.Empty();
+	OriginalNodePositions.Empty();
+
 	TArray<UEdGraphNode*> InputNodeStack;
 	TArray<UEdGraphNode*> OutputNodeStack;
 	OutputNodeStack.Push(RootNode);
-	RootNode->Modify();
+	OriginalNodePositions.Add(RootNode, FIntPoint(RootNode->NodePosX, RootNode->NodePosY));
 
 	while (InputNodeStack.Num() > 0 || OutputNodeStack.Num() > 0)
 	{
@@ -341,12 +381,13 @@ void FEdGraphFormatter::InitNodePool()
 			continue;
 		}
 
-		if (NodePool.Contains(CurrentNode) || FBAUtils::IsNodePure(CurrentNode))
+		if (NodePoolSet.Contains(CurrentNode) || FBAUtils::IsNodePure(CurrentNode))
 		{
 			continue;
 		}
 
 		NodePool.Add(CurrentNode);
+		NodePoolSet.Add(CurrentNode);
 
 		TArray<EEdGraphPinDirection> Directions = { EGPD_Input, EGPD_Output };
 
@@ -363,14 +404,17 @@ void FEdGraphFormatter::InitNodePool()
 					UEdGraphPin* LinkedPin = Pin->LinkedTo[i];
 					UEdGraphNode* LinkedNode = LinkedPin->GetOwningNode();
 
-					if (NodePool.Contains(LinkedNode) ||
+					if (NodePoolSet.Contains(LinkedNode) ||
 						FBAUtils::IsNodePure(LinkedNode) ||
 						!GraphHandler->FilterSelectiveFormatting(LinkedNode, FormatterParameters.NodesToFormat))
 					{
 						continue;
 					}
 
-					LinkedNode->Modify();
+					if (!OriginalNodePositions.Contains(LinkedNode))
+					{
+						OriginalNodePositions.Add(LinkedNode, FIntPoint(LinkedNode->NodePosX, LinkedNode->NodePosY));
+					}
 
 					FBAUtils::StraightenPin(GraphHandler, Pin, LinkedPin);
 
@@ -640,7 +684,7 @@ void FEdGraphFormatter::FormatX(const bool bUseParameter)
 				}
 
 				VisitedLinks.Add(PinLink);
-				if (!NodePool.Contains(LinkedNode))
+				if (!NodePoolSet.Contains(LinkedNode))
 				{
 					continue;
 				}
@@ -903,7 +947,7 @@ void FEdGraphFormatter::FormatY_Recursive(
 				// }
 
 				if (VisitedLinks.Contains(Link)
-					|| !NodePool.Contains(OtherNode)
+					|| !NodePoolSet.Contains(OtherNode)
 					|| FBAUtils::IsNodePure(OtherNode)
 					|| NodesToCollisionCheck.Contains(OtherNode)
 					|| !bIsSameLink)
@@ -1149,7 +1193,7 @@ void FEdGraphFormatter::GetPinsOfSameHeight_Recursive(
 				// UE_LOG(LogBlueprintAssist, Warning, TEXT("Try Iterating (%s) %s"), *FBAUtils::GetNodeName(CurrentNode), *Link.ToString());
 
 				if (VisitedLinks.Contains(Link)
-					|| !NodePool.Contains(OtherNode)
+					|| !NodePoolSet.Contains(OtherNode)
 					|| FBAUtils::IsNodePure(OtherNode))
 				{
 					// UE_LOG(LogBlueprintAssist, Warning, TEXT("\tSkipping"));
@@ -1974,6 +2018,30 @@ bool FEdGraphFormatter::IsExecOrDelegatePin(UEdGraphPin* Pin)
 	return FBAUtils::IsExecPin(Pin) || bUseDelegatePins;
 }
 
+void FEdGraphFormatter::ModifyMovedNodes()
+{
+	// nodes which haven't moved yet are kept, so a later pass can still record them
+	for (auto It = OriginalNodePositions.CreateIterator(); It; ++It)
+	{
+		UEdGraphNode* Node = It.Key();
+		const FIntPoint OriginalPosition = It.Value();
+		const FIntPoint NewPosition(Node->NodePosX, Node->NodePosY);
+		if (NewPosition == OriginalPosition)
+		{
+			continue;
+		}
+
+		// the transaction must record the position from before formatting, so move the node back while it is saved
+		Node->NodePosX = OriginalPosition.X;
+		Node->NodePosY = OriginalPosition.Y;
+		Node->Modify();
+		Node->NodePosX = NewPosition.X;
+		Node->NodePosY = NewPosition.Y;
+
+		It.RemoveCurrent();
+	}
+}
+
 void FEdGraphFormatter::ModifyCommentNodes()
 {
 	for (UEdGraphNode_Comment* Comment : CommentHandler.GetComments())
@@ -2612,35 +2680,12 @@ void FEdGraphFormatter::CenterBranches(UEdGraphNode* CurrentNode, TArray<ChildBr
 }
 
 
-bool FEdGraphFormatter::AnyCollisionBetweenPins(UEdGraphPin* Pin, UEdGraphPin* OtherPin)
-{
-	TSet<UEdGraphNode*> FormattedNodes = GetFormattedGraphNodes();
-
-	const FVector2D PinPos = FBAUtils::GetPinPos(GraphHandler, Pin);
-	const FVector2D OtherPinPos = FBAUtils::GetPinPos(GraphHandler, OtherPin);
-
-	return NodeCollisionBetweenLocation(PinPos, OtherPinPos, { Pin->GetOwningNode(), OtherPin->GetOwningNode() });
-}
-
-bool FEdGraphFormatter::NodeCollisionBetweenLocation(FVector2D Start, FVector2D End, TSet<UEdGraphNode*> IgnoredNodes)
+void FEdGraphFormatter::BuildNodeBoundsGrid()
 {
-	TSet<UEdGraphNode*> FormattedNodes = GetFormattedGraphNodes();
+	NodeBoundsGrid.Reset();
 
-	for (UEdGraphNode* NodeToCollisionCheck : FormattedNodes)
+	for (UEdGraphNode* Node : GetFormattedNodes())
 	{
-		if (IgnoredNodes.Contains(NodeToCollisionCheck))
-		{
-			continue;
-		}
-
-		FSlateRect NodeBounds = FBAUtils::GetCachedNodeBounds(GraphHandler, NodeToCollisionCheck).ExtendBy(FMargin(0, TrackSpacing - 1));
-		if (FBAUtils::LineRectIntersection(NodeBounds, Start, End))
-		{
-			// UE_LOG(LogBlueprintAssist, Warning, TEXT("\tNode collision!"));
-			return true;
-		}
+		NodeBoundsGrid.AddNode(Node, FBAUtils::GetCachedNodeBounds(GraphHandler, Node));
 	}
-
-	return false;
 }
-
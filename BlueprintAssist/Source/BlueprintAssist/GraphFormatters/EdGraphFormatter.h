@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 
+#include "BANodeBoundsGrid.h"
 #include "BlueprintAssistCommentHandler.h"
 #include "BlueprintAssistSettings.h"
 #include "FormatterInterface.h"
@@ -79,6 +80,8 @@ public:
 
 	virtual FCommentHandler* GetCommentHandler() override { return &CommentHandler; }
 
+	virtual FBANodeBoundsGrid* GetNodeBoundsGrid() override { return NodeBoundsGrid.IsEmpty() ? nullptr : &NodeBoundsGrid; }
+
 	TArray<UEdGraphNode*> GetNodePool() const { return NodePool; }
 
 	UEdGraphNode* GetRootNode() const { return RootNode; }
@@ -102,8 +105,12 @@ private:
 	int NumRequiredBranches;
 
 	TArray<UEdGraphNode*> NodePool;
+	TSet<UEdGraphNode*> NodePoolSet;
 	TArray<UEdGraphNode*> NodeTree;
 
+	/** Positions of the pool nodes before formatting, used to only modify the nodes which moved */
+	TMap<UEdGraphNode*, FIntPoint> OriginalNodePositions;
+
 	TMap<UEdGraphNode*, TSharedPtr<FEdGraphParameterFormatter>> ParameterFormatterMap;
 
 	UEdGraphNode* NodeToKeepStill = nullptr;
@@ -128,6 +135,11 @@ private:
 
 	TMap<UEdGraphNode*, int> NodeHeightLevels;
 
+	/** Bounds of the formatted nodes, only valid while creating knot tracks */
+	FBANodeBoundsGrid NodeBoundsGrid;
+
+	void BuildNodeBoundsGrid();
+
 	void ExpandPendingNodes(bool bUseParameter);
 
 	void SimpleRelativeFormatting();
@@ -161,10 +173,6 @@ private:
 
 	void CenterBranches(UEdGraphNode* CurrentNode, TArray<ChildBranch>& ChildBranches, TSet<UEdGraphNode*>& NodesToCollisionCheck);
 
-	bool AnyCollisionBetweenPins(UEdGraphPin* Pin, UEdGraphPin* OtherPin);
-
-	bool NodeCollisionBetweenLocation(FVector2D Start, FVector2D End, TSet<UEdGraphNode*> IgnoredNodes);
-
 	void FormatParameterNodes();
 
 	void ResetRelativeToNodeToKeepStill(const FVector2D& SavedLocation);
@@ -173,6 +181,8 @@ private:
 
 	static bool IsExecOrDelegatePin(UEdGraphPin* Pin);
 
+	void ModifyMovedNodes();
+
 	void ModifyCommentNodes();
 
 	void GetPinsOfSameHeight();
@@ -536,10 +536,10 @@ void FEdGraphParameterFormatter::FormatX()
 			}
 			else
 			{
-				CurrentNode->Modify();
-
 				if (CurrentNode != RootNode)
 				{
+					CurrentNode->Modify();
+
 					FBAUtils::StraightenPin(GraphHandler, CurrentPinLink);
 
 					if (InitialDirection == EGPD_Input && CurrentPinLink.GetDirection() == EGPD_Input && (FormattedInputNodes.Contains(ParentNode) || ParentNode == RootNode))
@@ -6,6 +6,7 @@
 #include "BlueprintAssistSettings.h"
 
 struct FCommentHandler;
+class FBANodeBoundsGrid;
 class UEdGraphNode;
 
 struct BLUEPRINTASSIST_API FFormatterInterface
@@ -17,4 +18,5 @@ struct BLUEPRINTASSIST_API FFormatterInterface
 	virtual UEdGraphNode* GetRootNode() = 0;
 	virtual FBAFormatterSettings GetFormatterSettings() { return FBAFormatterSettings(); }
 	virtual FCommentHandler* GetCommentHandler() { return nullptr; }
+	virtual FBANodeBoundsGrid* GetNodeBoundsGrid() { return nullptr; }
 };
@@ -5,6 +5,7 @@
 #include "BlueprintAssistGraphHandler.h"
 #include "BlueprintAssistUtils.h"
 #include "K2Node_Knot.h"
+#include "BlueprintAssist/GraphFormatters/BANodeBoundsGrid.h"
 #include "BlueprintAssist/GraphFormatters/FormatterInterface.h"
 
 UEdGraphPin* FKnotNodeCreation::GetPinToConnectTo() const
@@ -135,7 +136,6 @@ TArray<FGraphPinHandle> FKnotNodeTrack::GetLinkedToSafe()
 void FKnotNodeTrack::SetTrackHeight(TSharedPtr<FFormatterInterface> Formatter)
 {
 	const float TrackSpacing = GetDefault<UBASettings>()->BlueprintKnotTrackSpacing;
-	const TArray<UEdGraphNode*>& AllNodes = Formatter->GetFormattedNodes().Array();
 
 	UEdGraphPin* LastPin = GetLastPin();
 
@@ -165,6 +165,10 @@ void FKnotNodeTrack::SetTrackHeight(TSharedPtr<FFormatterInterface> Formatter)
 
 	float TestSolution = StartingPoint;
 
+	// only the nodes along the track need to be checked if the formatter has a node bounds grid
+	FBANodeBoundsGrid* NodeBoundsGrid = Formatter->GetNodeBoundsGrid();
+	const TArray<UEdGraphNode*> AllNodes = NodeBoundsGrid ? TArray<UEdGraphNode*>() : Formatter->GetFormattedNodes().Array();
+
 	for (int i = 0; i < 100; ++i)
 	{
 		bool bNoCollisionInDirection = true;
@@ -172,7 +176,13 @@ void FKnotNodeTrack::SetTrackHeight(TSharedPtr<FFormatterInterface> Formatter)
 		FVector2D StartPoint(TrackStart, TestSolution);
 		FVector2D EndPoint(TrackEnd, TestSolution);
 
-		for (UEdGraphNode* NodeToCollisionCheck : AllNodes)
+		TArray<UEdGraphNode*> NodesAlongTrack;
+		if (NodeBoundsGrid)
+		{
+			NodeBoundsGrid->FindLineIntersections(StartPoint, EndPoint, FMargin(0, TrackSpacing - 1), NodesAlongTrack);
+		}
+
+		for (UEdGraphNode* NodeToCollisionCheck : NodeBoundsGrid ? NodesAlongTrack : AllNodes)
 		{
 			FSlateRect NodeBounds = FBAUtils::GetCachedNodeBounds(GraphHandler, NodeToCollisionCheck).ExtendBy(FMargin(0, TrackSpacing - 1));
 
@@ -257,6 +267,13 @@ bool FKnotNodeTrack::TryAlignTrack(TSharedPtr<FFormatterInterface> Formatter, fl
 	UEdGraphPin* MyPin = ParentPin;
 	UEdGraphPin* LastPin = GetLastPin();
 
+	if (FBANodeBoundsGrid* NodeBoundsGrid = Formatter->GetNodeBoundsGrid())
+	{
+		const FVector2D StartPoint(TrackStart, TestHeight);
+		const FVector2D EndPoint(TrackEnd, TestHeight);
+		return !NodeBoundsGrid->AnyLineIntersection(StartPoint, EndPoint, FMargin(0, TrackSpacing - 1), { MyPin->GetOwningNode(), LastPin->GetOwningNode() });
+	}
+
 	const TArray<UEdGraphNode*>& AllNodes = Formatter->GetFormattedNodes().Array();
 	for (UEdGraphNode* NodeToCollisionCheck : AllNodes)
 	{
@@ -5,6 +5,7 @@
 #include "BlueprintAssistGlobals.h"
 #include "BlueprintAssistGraphHandler.h"
 #include "BlueprintAssistUtils.h"
+#include "BlueprintAssist/GraphFormatters/BANodeBoundsGrid.h"
 #include "EdGraphNode_Comment.h"
 #include "K2Node_Knot.h"
 #include "BlueprintAssist/GraphFormatters/BlueprintAssistCommentHandler.h"
@@ -420,7 +421,18 @@ void FKnotTrackCreator::ExpandKnotTracks()
 		float CollisionTop = MAX_flt;
 
 		// collide against nodes
-		for (UEdGraphNode* Node : Formatter->GetFormattedNodes())
+		FBANodeBoundsGrid* NodeBoundsGrid = Formatter->GetNodeBoundsGrid();
+		TArray<UEdGraphNode*> NodesToCollisionCheck;
+		if (NodeBoundsGrid)
+		{
+			NodeBoundsGrid->FindRectIntersections(ExpandedBounds, NodesToCollisionCheck);
+		}
+		else
+		{
+			NodesToCollisionCheck = Formatter->GetFormattedNodes().Array();
+		}
+
+		for (UEdGraphNode* Node : NodesToCollisionCheck)
 		{
 			// if (Node == CurrentTrack->LinkedTo[0]->GetOwningNode() || Node == CurrentTrack->GetLastPin()->GetOwningNode())
 			// 	continue;
@@ -485,6 +497,11 @@ void FKnotTrackCreator::ExpandKnotTracks()
 			{
 				Node->NodePosY += Delta;
 				MovedNodes.Add(Node);
+
+				if (NodeBoundsGrid)
+				{
+					NodeBoundsGrid->UpdateNode(Node, GraphHandler->GetCachedNodeBounds(Node));
+				}
 				// UE_LOG(LogBlueprintAssist, Warning, TEXT("\t Moved node %s by delta %f"), *FBAUtils::GetNodeName(Node), Delta);
 			}
 		}
@@ -608,7 +625,7 @@ UK2Node_Knot* FKnotTrackCreator::CreateKnotNode(FKnotNodeCreation* Creation, con
 	return CreatedNode; //Creation->CreateKnotNode(Position, ParentPin, OptionalNodeToReuse, GraphHandler->GetFocusedEdGraph());
 }
 
-bool FKnotTrackCreator::TryAlignTrackToEndPins(TSharedPtr<FKnotNodeTrack> Track, const TArray<UEdGraphNode*>& AllNodes)
+bool FKnotTrackCreator::TryAlignTrackToEndPins(TSharedPtr<FKnotNodeTrack> Track)
 {
 	const float ParentPinY = GraphHandler->GetPinY(Track->ParentPin);
 	const float LastPinY = GraphHandler->GetPinY(Track->GetLastPin());
@@ -647,27 +664,7 @@ bool FKnotTrackCreator::TryAlignTrackToEndPins(TSharedPtr<FKnotNodeTrack> Track,
 
 		// UE_LOG(LogBlueprintAssist, Error, TEXT("Checking Point %s | %s"), *Point.ToString(), *FBAUtils::GetNodeName(SourcePin->GetOwningNode()));
 
-		bool bAnyCollision = false;
-
-		for (UEdGraphNode* NodeToCollisionCheck : AllNodes)
-		{
-			FSlateRect CollisionBounds = FBAUtils::GetCachedNodeBounds(GraphHandler, NodeToCollisionCheck).ExtendBy(FMargin(0, TrackSpacing - 1));
-
-			// UE_LOG(LogBlueprintAssist, Warning, TEXT("Collision check against %s | %s | %s"), *FBAUtils::GetNodeName(NodeToCollisionCheck), *CollisionBounds.ToString(), *Point.ToString());
-
-			if (NodeToCollisionCheck == SourcePin->GetOwningNode() || NodeToCollisionCheck == OtherPin->GetOwningNode())
-			{
-				// UE_LOG(LogBlueprintAssist, Warning, TEXT("\tSkipping node"));
-				continue;
-			}
-
-			if (FBAUtils::LineRectIntersection(CollisionBounds, SourcePinPos, Point))
-			{
-				// UE_LOG(LogBlueprintAssist, Warning, TEXT("\tFound collision"));
-				bAnyCollision = true;
-				break;
-			}
-		}
+		bool bAnyCollision = NodeCollisionBetweenLocation(SourcePinPos, Point, { SourcePin->GetOwningNode(), OtherPin->GetOwningNode() });
 
 		for (TSharedPtr<FKnotNodeTrack> OtherTrack : KnotTracks)
 		{
@@ -723,16 +720,19 @@ bool FKnotTrackCreator::DoesPinNeedTrack(UEdGraphPin* Pin, const TArray<UEdGraph
 
 bool FKnotTrackCreator::AnyCollisionBetweenPins(UEdGraphPin* Pin, UEdGraphPin* OtherPin)
 {
-	TSet<UEdGraphNode*> FormattedNodes = Formatter->GetFormattedNodes();
-
 	const FVector2D PinPos = FBAUtils::GetPinPos(GraphHandler, Pin);
 	const FVector2D OtherPinPos = FBAUtils::GetPinPos(GraphHandler, OtherPin);
 
 	return NodeCollisionBetweenLocation(PinPos, OtherPinPos, { Pin->GetOwningNode(), OtherPin->GetOwningNode() });
 }
 
-bool FKnotTrackCreator::NodeCollisionBetweenLocation(FVector2D Start, FVector2D End, TSet<UEdGraphNode*> IgnoredNodes)
+bool FKnotTrackCreator::NodeCollisionBetweenLocation(FVector2D Start, FVector2D End, const TSet<UEdGraphNode*>& IgnoredNodes)
 {
+	if (FBANodeBoundsGrid* NodeBoundsGrid = Formatter->GetNodeBoundsGrid())
+	{
+		return NodeBoundsGrid->AnyLineIntersection(Start, End, FMargin(0, TrackSpacing - 1), IgnoredNodes);
+	}
+
 	TSet<UEdGraphNode*> FormattedNodes = Formatter->GetFormattedNodes();
 
 	for (UEdGraphNode* NodeToCollisionCheck : FormattedNodes)
@@ -944,7 +944,7 @@ TSharedPtr<FKnotNodeTrack> FKnotTrackCreator::MakeKnotTracksForLinkedExecPins(UE
 	TSharedPtr<FKnotNodeTrack> KnotTrack = MakeShared<FKnotNodeTrack>(Formatter, GraphHandler, ParentPin, LinkedPins, ParentPinPos.Y, false);
 	KnotTracks.Add(KnotTrack);
 
-	TryAlignTrackToEndPins(KnotTrack, Formatter->GetFormattedNodes().Array());
+	TryAlignTrackToEndPins(KnotTrack);
 
 	// if the track is not at the same height as the pin, then we need an
 	// initial knot right of the inital pin, at the track height
@@ -1043,7 +1043,7 @@ TSharedPtr<FKnotNodeTrack> FKnotTrackCreator::MakeKnotTracksForParameterPins(UEd
 	KnotTracks.Add(KnotTrack);
 
 	// check if the track height can simply be set to one of it's pin's height
-	if (TryAlignTrackToEndPins(KnotTrack, Formatter->GetFormattedNodes().Array()))
+	if (TryAlignTrackToEndPins(KnotTrack))
 	{
 		// UE_LOG(LogBlueprintAssist, Warning, TEXT("Found a pin to align to for %s"), *FBAUtils::GetPinName(KnotTrack->ParentPin));
 	}
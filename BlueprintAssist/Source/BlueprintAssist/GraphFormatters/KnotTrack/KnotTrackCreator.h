@@ -46,13 +46,13 @@ private:
 
 	void CreateKnotTracks();
 
-	bool TryAlignTrackToEndPins(TSharedPtr<FKnotNodeTrack> Track, const TArray<UEdGraphNode*>& AllNodes);
+	bool TryAlignTrackToEndPins(TSharedPtr<FKnotNodeTrack> Track);
 
 	bool DoesPinNeedTrack(UEdGraphPin* Pin, const TArray<UEdGraphPin*>& LinkedTo);
 
 	bool AnyCollisionBetweenPins(UEdGraphPin* Pin, UEdGraphPin* OtherPin);
 
-	bool NodeCollisionBetweenLocation(FVector2D Start, FVector2D End, TSet<UEdGraphNode*> IgnoredNodes);
+	bool NodeCollisionBetweenLocation(FVector2D Start, FVector2D End, const TSet<UEdGraphNode*>& IgnoredNodes);
 
 	UK2Node_Knot* CreateKnotNode(FKnotNodeCreation* Creation, const FVector2D& Position, UEdGraphPin* ParentPin);
 
@@ -2,6 +2,7 @@
 
 #include "SimpleFormatter.h"
 
+#include "BAFormatterTimings.h"
 #include "BAFormatterUtils.h"
 #include "BlueprintAssistUtils.h"
 #include "EdGraphNode_Comment.h"
@@ -25,11 +26,17 @@ void FSimpleFormatter::FormatNode(UEdGraphNode* Node)
 	int32 SavedNodePosX = RootNode->NodePosX;
 	int32 SavedNodePosY = RootNode->NodePosY;
 
-	FormatX();
+	{
+		BA_FORMATTER_PHASE("FormatX");
+		FormatX();
+	}
 
 	CommentHandler.Init(GraphHandler, SharedThis(this));
 
-	FormatY();
+	{
+		BA_FORMATTER_PHASE("FormatY");
+		FormatY();
+	}
 
 	// UE_LOG(LogTemp, Warning, TEXT("Same row mapping"));
 	// for (auto Kvp : SameRowMapping)
@@ -39,11 +46,13 @@ void FSimpleFormatter::FormatNode(UEdGraphNode* Node)
 
 	if (GetDefault<UBASettings>()->bApplyCommentPadding)
 	{
+		BA_FORMATTER_PHASE("CommentPadding");
 		ApplyCommentPaddingX();
 	}
 
 	if (GetDefault<UBASettings>()->bApplyCommentPadding)
 	{
+		BA_FORMATTER_PHASE("CommentPadding");
 		ApplyCommentPaddingY();
 	}
 
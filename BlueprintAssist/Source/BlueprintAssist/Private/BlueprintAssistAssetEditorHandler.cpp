@@ -173,6 +173,20 @@ void FBAAssetEditorHandler::CheckInvalidAssetEditors()
 	}
 }
 
+FBABlueprintHandler* FBAAssetEditorHandler::GetBlueprintHandler(UBlueprint* Blueprint)
+{
+	if (Blueprint)
+	{
+		FBABlueprintHandler* FoundHandler = BlueprintHandlers.Find(Blueprint->GetBlueprintGuid());
+		if (FoundHandler && FoundHandler->IsBoundTo(Blueprint))
+		{
+			return FoundHandler;
+		}
+	}
+
+	return nullptr;
+}
+
 TSharedPtr<SDockTab> FBAAssetEditorHandler::GetTabForAsset(UObject* Asset) const
 {
 	if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
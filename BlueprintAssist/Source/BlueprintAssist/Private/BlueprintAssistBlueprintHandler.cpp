@@ -13,6 +13,7 @@
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "Logging/MessageLog.h"
+#include "BlueprintAssist/BlueprintAssistWidgets/GoToSymbolMenu.h"
 
 const FName& FBAVariableDescription::GetMetaData(FName Key) const
 {
@@ -40,6 +41,8 @@ int32 FBAVariableDescription::FindMetaDataEntryIndexForKey(FName Key) const
 
 FBABlueprintHandler::~FBABlueprintHandler()
 {
+	ClearSymbols();
+
 	if (BlueprintPtr.IsValid())
 	{
 		BlueprintPtr->OnChanged().RemoveAll(this);
@@ -60,6 +63,8 @@ void FBABlueprintHandler::BindBlueprintChanged(UBlueprint* Blueprint)
 	bProcessedChangesThisFrame = false;
 	bActive = true;
 
+	ClearSymbols();
+
 	Blueprint->OnChanged().RemoveAll(this);
 	Blueprint->OnChanged().AddRaw(this, &FBABlueprintHandler::OnBlueprintChanged);
 
@@ -79,6 +84,8 @@ void FBABlueprintHandler::UnbindBlueprintChanged(UBlueprint* Blueprint)
 	bProcessedChangesThisFrame = false;
 	bActive = false;
 
+	ClearSymbols();
+
 	if (BlueprintPtr.IsValid() && BlueprintPtr->IsValidLowLevelFast())
 	{
 		BlueprintPtr->OnChanged().RemoveAll(this);
@@ -123,6 +130,9 @@ void FBABlueprintHandler::OnBlueprintChanged(UBlueprint* Blueprint)
 		return;
 	}
 
+	// graphs may have been added, removed or moved, check them the next time the symbols are requested
+	bSymbolGraphsDirty = true;
+
 	if (bProcessedChangesThisFrame)
 	{
 		return;
@@ -497,6 +507,136 @@ void FBABlueprintHandler::OnBlueprintCompiled(UBlueprint* Blueprint)
 	}
 }
 
+const TArray<TSharedPtr<FGoToSymbolStruct>>& FBABlueprintHandler::GetSymbols()
+{
+	UBlueprint* Blueprint = BlueprintPtr.Get();
+	if (!Blueprint)
+	{
+		ClearSymbols();
+		return Symbols;
+	}
+
+	if (bSymbolGraphsDirty)
+	{
+		UpdateSymbolGraphs(Blueprint);
+	}
+
+	for (FBASymbolGraph& SymbolGraph : SymbolGraphs)
+	{
+		if (SymbolGraph.bDirty)
+		{
+			SymbolGraph.Symbols.Reset();
+			if (UEdGraph* Graph = SymbolGraph.Graph.Get())
+			{
+				SGoToSymbolMenu::GetGraphSymbols(Graph, SymbolGraph.Symbols);
+			}
+
+			SymbolGraph.bDirty = false;
+			bSymbolsDirty = true;
+		}
+	}
+
+	if (bSymbolsDirty)
+	{
+		Symbols.Reset();
+		for (const FBASymbolGraph& SymbolGraph : SymbolGraphs)
+		{
+			Symbols.Append(SymbolGraph.Symbols);
+		}
+
+		bSymbolsDirty = false;
+	}
+
+	return Symbols;
+}
+
+void FBABlueprintHandler::UpdateSymbolGraphs(UBlueprint* Blueprint)
+{
+	TArray<UEdGraph*> BlueprintGraphs;
+	Blueprint->GetAllGraphs(BlueprintGraphs);
+
+	TMap<UEdGraph*, int32> OldGraphIndices;
+	for (int32 i = 0; i < SymbolGraphs.Num(); ++i)
+	{
+		OldGraphIndices.Add(SymbolGraphs[i].Graph.Get(), i);
+	}
+
+	TArray<FBASymbolGraph> NewSymbolGraphs;
+	NewSymbolGraphs.Reserve(BlueprintGraphs.Num());
+
+	for (UEdGraph* Graph : BlueprintGraphs)
+	{
+		if (Blueprint->DelegateSignatureGraphs.Contains(Graph))
+		{
+			continue;
+		}
+
+		int32 OldIndex = INDEX_NONE;
+		if (OldGraphIndices.RemoveAndCopyValue(Graph, OldIndex))
+		{
+			NewSymbolGraphs.Add(MoveTemp(SymbolGraphs[OldIndex]));
+			continue;
+		}
+
+		FBASymbolGraph& SymbolGraph = NewSymbolGraphs.AddDefaulted_GetRef();
+		SymbolGraph.Graph = Graph;
+
+		// event nodes are only listed for ubergraphs, other graphs only need to know about graph changes
+		if (FBAUtils::GetGraphType(Graph) == GT_Ubergraph)
+		{
+			SymbolGraph.GraphChangedHandle = Graph->AddOnGraphChangedHandler(
+				FOnGraphChanged::FDelegate::CreateRaw(this, &FBABlueprintHandler::OnSymbolGraphChanged, TWeakObjectPtr<UEdGraph>(Graph)));
+		}
+	}
+
+	// unbind the graphs which were removed
+	for (const auto& Kvp : OldGraphIndices)
+	{
+		const FBASymbolGraph& OldGraph = SymbolGraphs[Kvp.Value];
+		if (OldGraph.Graph.IsValid() && OldGraph.GraphChangedHandle.IsValid())
+		{
+			OldGraph.Graph->RemoveOnGraphChangedHandler(OldGraph.GraphChangedHandle);
+		}
+	}
+
+	SymbolGraphs = MoveTemp(NewSymbolGraphs);
+	bSymbolGraphsDirty = false;
+	bSymbolsDirty = true;
+}
+
+void FBABlueprintHandler::OnSymbolGraphChanged(const FEdGraphEditAction& Action, TWeakObjectPtr<UEdGraph> Graph)
+{
+	if (!(Action.Action & (GRAPHACTION_AddNode | GRAPHACTION_RemoveNode)))
+	{
+		return;
+	}
+
+	for (FBASymbolGraph& SymbolGraph : SymbolGraphs)
+	{
+		if (SymbolGraph.Graph == Graph)
+		{
+			SymbolGraph.bDirty = true;
+			return;
+		}
+	}
+}
+
+void FBABlueprintHandler::ClearSymbols()
+{
+	for (const FBASymbolGraph& SymbolGraph : SymbolGraphs)
+	{
+		if (SymbolGraph.Graph.IsValid() && SymbolGraph.GraphChangedHandle.IsValid())
+		{
+			SymbolGraph.Graph->RemoveOnGraphChangedHandler(SymbolGraph.GraphChangedHandle);
+		}
+	}
+
+	SymbolGraphs.Empty();
+	Symbols.Empty();
+	bSymbolGraphsDirty = true;
+	bSymbolsDirty = true;
+}
+
 void FBABlueprintHandler::DetectGraphIssues(UEdGraph* Graph)
 {
 	if (!IsValid(Graph))
@@ -12,6 +12,7 @@
 #include "K2Node_CallParentFunction.h"
 #include "K2Node_ComponentBoundEvent.h"
 #include "K2Node_CustomEvent.h"
+#include "NodeFactory.h"
 #include "SCommentBubble.h"
 #include "ScopedTransaction.h"
 #include "SGraphPanel.h"
@@ -43,6 +44,12 @@ FBAGraphHandler::FBAGraphHandler(
 	FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FBAGraphHandler::OnObjectTransacted);
 }
 
+FBAGraphHandler::FBAGraphHandler(UEdGraph* InGraph)
+	: CachedEdGraph(InGraph)
+{
+	check(InGraph != nullptr);
+}
+
 FBAGraphHandler::~FBAGraphHandler()
 {
 	if (OnGraphChangedHandle.IsValid())
@@ -58,6 +65,7 @@ FBAGraphHandler::~FBAGraphHandler()
 	FocusedNode = nullptr;
 	LastSelectedNode = nullptr;
 	LastNodes.Empty();
+	PendingAddedNodes.Empty();
 	ResetTransactions();
 
 	FCoreUObjectDelegates::OnObjectTransacted.RemoveAll(this);
@@ -99,7 +107,10 @@ void FBAGraphHandler::InitGraphHandler()
 	CachedEdGraph.Reset();
 	CachedEdGraph = GetFocusedEdGraph();
 
-	GetGraphCache().CleanupGraph(GetFocusedEdGraph());
+	if (GetGraphCache().CleanupGraph(GetFocusedEdGraph()))
+	{
+		FBASizeCache::Get().MarkGraphDirty(GetFocusedEdGraph());
+	}
 
 	GetGraphEditor()->GetViewLocation(LastGraphView, LastZoom);
 
@@ -113,7 +124,7 @@ void FBAGraphHandler::InitGraphHandler()
 
 void FBAGraphHandler::OnGraphInitializedDelayed()
 {
-	LastNodes = GetFocusedEdGraph()->Nodes;
+	ResetLastNodes();
 
 	if (GetDefault<UBASettings>()->bDetectNewNodesAndCacheNodeSizes)
 	{
@@ -755,26 +766,70 @@ void FBAGraphHandler::MoveUnrelatedNodes(TSharedPtr<FFormatterInterface> Formatt
 
 void FBAGraphHandler::OnGraphChanged(const FEdGraphEditAction& Action)
 {
+	if (Action.Nodes.Num() == 0)
+	{
+		bRescanAllNodes = true;
+	}
+	else if (Action.Action & GRAPHACTION_AddNode)
+	{
+		for (const UEdGraphNode* Node : Action.Nodes)
+		{
+			PendingAddedNodes.Add(const_cast<UEdGraphNode*>(Node));
+		}
+	}
+	else if (Action.Action & GRAPHACTION_RemoveNode)
+	{
+		for (const UEdGraphNode* Node : Action.Nodes)
+		{
+			LastNodes.Remove(const_cast<UEdGraphNode*>(Node));
+			PendingAddedNodes.Remove(const_cast<UEdGraphNode*>(Node));
+		}
+	}
+
 	DelayedDetectGraphChanges.StartDelay(1);
 }
 
 void FBAGraphHandler::DetectGraphChanges()
 {
+	UEdGraph* Graph = GetFocusedEdGraph();
+
 	TArray<UEdGraphNode*> NewNodes;
-	for (UEdGraphNode* NewNode : GetFocusedEdGraph()->Nodes)
+	const auto& CheckNewNode = [&](UEdGraphNode* Node)
 	{
-		if (FBAUtils::IsCommentNode(NewNode) || FBAUtils::IsKnotNode(NewNode))
+		bool bAlreadyKnown = false;
+		LastNodes.Add(Node, &bAlreadyKnown);
+
+		if (!bAlreadyKnown && !FBAUtils::IsCommentNode(Node) && !FBAUtils::IsKnotNode(Node))
 		{
-			continue;
+			NewNodes.Add(Node);
 		}
+	};
 
-		if (!LastNodes.Contains(NewNode))
+	if (bRescanAllNodes)
+	{
+		TSet<UEdGraphNode*> CurrentNodes(Graph->Nodes);
+		for (UEdGraphNode* Node : Graph->Nodes)
 		{
-			NewNodes.Add(NewNode);
+			CheckNewNode(Node);
+		}
+
+		LastNodes = MoveTemp(CurrentNodes);
+	}
+	else
+	{
+		for (const TWeakObjectPtr<UEdGraphNode>& WeakNode : PendingAddedNodes)
+		{
+			// removing a node keeps its outer, so also check it is still one of the graph's nodes
+			UEdGraphNode* Node = WeakNode.Get();
+			if (Node && Node->GetGraph() == Graph && Graph->Nodes.Contains(Node))
+			{
+				CheckNewNode(Node);
+			}
 		}
 	}
 
-	LastNodes = GetFocusedEdGraph()->Nodes;
+	PendingAddedNodes.Reset();
+	bRescanAllNodes = false;
 
 	if (NewNodes.Num() > 0)
 	{
@@ -782,6 +837,13 @@ void FBAGraphHandler::DetectGraphChanges()
 	}
 }
 
+void FBAGraphHandler::ResetLastNodes()
+{
+	LastNodes = TSet<UEdGraphNode*>(GetFocusedEdGraph()->Nodes);
+	PendingAddedNodes.Reset();
+	bRescanAllNodes = false;
+}
+
 void FBAGraphHandler::OnNodesAdded(const TArray<UEdGraphNode*>& NewNodes)
 {
 	for (UEdGraphNode* Node : NewNodes)
@@ -1150,7 +1212,7 @@ void FBAGraphHandler::OnObjectTransacted(UObject* Object, const FTransactionObje
 			{
 				if (Graph == GetFocusedEdGraph())
 				{
-					LastNodes = GetFocusedEdGraph()->Nodes;
+					ResetLastNodes();
 				}
 			}
 		}
@@ -1780,6 +1842,18 @@ void FBAGraphHandler::UpdateCachedNodeSize(float DeltaTime)
 
 	PendingSize.RemoveAll(FBAUtils::IsNodeDeleted);
 
+	// Measure what we can offscreen so the viewport only needs to visit the remaining nodes
+	if (GetDefault<UBASettings>()->bOffscreenSizeCaching && PendingSize.Num() > 0)
+	{
+		TArray<UEdGraphNode*> NodesCachedOffscreen;
+		CacheNodeSizesOffscreen(PendingSize, NodesCachedOffscreen);
+
+		for (UEdGraphNode* Node : NodesCachedOffscreen)
+		{
+			PendingSize.RemoveSwap(Node);
+		}
+	}
+
 	// Save the currently viewport to restore once we are done
 	if (PendingSize.Num() > 0 && !bFullyZoomed)
 	{
@@ -1916,6 +1990,11 @@ void FBAGraphHandler::UpdateCachedNodeSize(float DeltaTime)
 		PendingSize.RemoveSwap(Node);
 	}
 
+	if (PendingSize.Num() == 0)
+	{
+		OffscreenSizeFailed.Reset();
+	}
+
 	if (PendingSize.Num() == 0 && bFullyZoomed)
 	{
 		GetGraphEditor()->SetViewLocation(ViewCache, ZoomCache);
@@ -2035,14 +2114,14 @@ void FBAGraphHandler::UpdateNodesRequiringFormatting()
 void FBAGraphHandler::SimpleFormatAll()
 {
 	TSet<UEdGraphNode*> FormattedNodes;
-	FSlateRect FormattedBounds;
 
-	int32 ColumnX = 0;
+	// format every tree first, then lay out the columns using only the tree bounds
+	TArray<FBAFormatAllTree> Trees;
+	TArray<TArray<int32>> ColumnTrees;
+	ColumnTrees.SetNum(FormatAllColumns.Num());
 
 	for (int i = 0; i < FormatAllColumns.Num(); ++i)
 	{
-		bool bFirst = true;
-
 		for (UEdGraphNode* Node : FormatAllColumns[i])
 		{
 			if (FormattedNodes.Contains(Node))
@@ -2059,64 +2138,40 @@ void FBAGraphHandler::SimpleFormatAll()
 				continue;
 			}
 
-			FSlateRect CurrentBounds = GetDefault<UBASettings>()->bApplyCommentPadding
-				? FBAUtils::GetCachedNodeArrayBoundsWithComments(AsShared(), Formatter->GetCommentHandler(), Formatter->GetFormattedNodes().Array())
-				: FBAUtils::GetCachedNodeArrayBounds(AsShared(), Formatter->GetFormattedNodes().Array());
-
-			// align the position of the formatted nodes to the column
-			const int32 DeltaX = ColumnX - CurrentBounds.Left;
-
-			// offset the first formatted node's Y position to zero
-			const int32 DeltaY = bFirst ? 0 - CurrentBounds.Top : 0;
-
-			for (auto FormattedNode : Formatter->GetFormattedNodes())
-			{
-				FormattedNode->NodePosX += DeltaX;
-				FormattedNode->NodePosY += DeltaY;
-			}
-
-			FormattedNodes.Append(Formatter->GetFormattedNodes());
-
-			// update the bounds again after moving nodes
-			CurrentBounds = GetDefault<UBASettings>()->bApplyCommentPadding
-				? FBAUtils::GetCachedNodeArrayBoundsWithComments(AsShared(), Formatter->GetCommentHandler(), Formatter->GetFormattedNodes().Array())
-				: FBAUtils::GetCachedNodeArrayBounds(AsShared(), Formatter->GetFormattedNodes().Array());
-
-			if (bFirst)
-			{
-				bFirst = false;
-				FormattedBounds = CurrentBounds;
-			}
-			else
-			{
-				const float Delta = (FormattedBounds.Bottom + GetDefault<UBASettings>()->FormatAllPadding.Y) - CurrentBounds.Top;
-				for (UEdGraphNode* FormattedNode : Formatter->GetFormattedNodes())
-				{
-					FormattedNode->NodePosY += Delta;
-				}
+			const int32 TreeIndex = Trees.Add(MakeFormatAllTree(Formatter));
+			FormattedNodes.Append(Trees[TreeIndex].Nodes);
+			ColumnTrees[i].Add(TreeIndex);
+		}
+	}
 
-				// update the bounds again after moving nodes (again)
-				CurrentBounds = GetDefault<UBASettings>()->bApplyCommentPadding
-					? FBAUtils::GetCachedNodeArrayBoundsWithComments(AsShared(), Formatter->GetCommentHandler(), Formatter->GetFormattedNodes().Array())
-					: FBAUtils::GetCachedNodeArrayBounds(AsShared(), Formatter->GetFormattedNodes().Array());
+	int32 ColumnX = 0;
 
-				FormattedBounds = FormattedBounds.Expand(CurrentBounds);
-			}
+	for (const TArray<int32>& TreeIndices : ColumnTrees)
+	{
+		if (TreeIndices.Num() == 0)
+		{
+			continue;
 		}
 
-		if (!bFirst) // if bFirst is false that also means we formatted at least 1 node
+		TArray<FBAFormatAllTree*> Column;
+		for (int32 TreeIndex : TreeIndices)
 		{
-			ColumnX = FormattedBounds.Right + GetMutableDefault<UBASettings>()->FormatAllPadding.X;
+			Column.Add(&Trees[TreeIndex]);
 		}
+
+		const FSlateRect FormattedBounds = StackFormatAllColumn(Column, ColumnX);
+		ColumnX = FormattedBounds.Right + GetMutableDefault<UBASettings>()->FormatAllPadding.X;
 	}
 
+	ApplyFormatAllTrees(Trees);
+
 	FormatAllColumns.Empty();
 	FormatAllTransaction.Reset();
 }
 
 void FBAGraphHandler::SmartFormatAll()
 {
-	TArray<TSharedPtr<FFormatterInterface>> AllFormatters;
+	TArray<FBAFormatAllTree> Trees;
 
 	// format all the nodes
 	TSet<UEdGraphNode*> PreviouslyFormattedNodes;
@@ -2131,128 +2186,146 @@ void FBAGraphHandler::SmartFormatAll()
 		Node->Modify();
 
 		TSharedPtr<FFormatterInterface> Formatter = FormatNodes(Node, true);
-		AllFormatters.Add(Formatter);
+		if (!Formatter.IsValid())
+		{
+			continue;
+		}
+
+		const int32 TreeIndex = Trees.Add(MakeFormatAllTree(Formatter));
 
-		PreviouslyFormattedNodes.Append(Formatter->GetFormattedNodes());
+		PreviouslyFormattedNodes.Append(Trees[TreeIndex].Nodes);
 	}
 
-	float ColumnX = 0;
-	while (AllFormatters.Num() > 0)
+	// sort formatted trees by left most, trees are only moved once they are placed so this order holds for the remaining trees
+	TArray<FBAFormatAllTree*> RemainingTrees;
+	for (FBAFormatAllTree& Tree : Trees)
 	{
-		TArray<TSharedPtr<FFormatterInterface>> AllFormattersCopy = AllFormatters;
+		RemainingTrees.Add(&Tree);
+	}
 
-		// sort formatted nodes by left most
-		AllFormattersCopy.Sort([](TSharedPtr<FFormatterInterface> FormatterA, TSharedPtr<FFormatterInterface> FormatterB)
+	RemainingTrees.StableSort([](const FBAFormatAllTree& TreeA, const FBAFormatAllTree& TreeB)
+	{
+		if (TreeA.RootPosition.X != TreeB.RootPosition.X)
 		{
-			UEdGraphNode* RootA = FormatterA->GetRootNode();
-			UEdGraphNode* RootB = FormatterB->GetRootNode();
-			if (RootA->NodePosX != RootB->NodePosX)
-			{
-				return RootA->NodePosX < RootB->NodePosX;
-			}
+			return TreeA.RootPosition.X < TreeB.RootPosition.X;
+		}
 
-			return RootA->NodePosY < RootB->NodePosY;
-		});
+		return TreeA.RootPosition.Y < TreeB.RootPosition.Y;
+	});
 
+	float ColumnX = 0;
+	while (RemainingTrees.Num() > 0)
+	{
 		// get the bounds of the left most node
-		TSharedPtr<FFormatterInterface> LeftMostNodeTree = AllFormattersCopy[0];
-		const FSlateRect LeftMostNodeBounds = GetDefault<UBASettings>()->bApplyCommentPadding
-				? FBAUtils::GetCachedNodeArrayBoundsWithComments(AsShared(), LeftMostNodeTree->GetCommentHandler(), LeftMostNodeTree->GetFormattedNodes().Array())
-				: FBAUtils::GetCachedNodeArrayBounds(AsShared(), LeftMostNodeTree->GetFormattedNodes().Array());
-		float ColumnRight = ColumnX + LeftMostNodeBounds.GetSize().X;
+		FBAFormatAllTree* LeftMostNodeTree = RemainingTrees[0];
+		float ColumnRight = ColumnX + LeftMostNodeTree->Bounds.GetSize().X;
 
-		TArray<TSharedPtr<FFormatterInterface>> CurrentColumn;
+		TArray<FBAFormatAllTree*> CurrentColumn;
 		CurrentColumn.Add(LeftMostNodeTree);
 
 		// create columns by checking for overlapping formatted node-trees
-		for (TSharedPtr<FFormatterInterface> Formatter : AllFormattersCopy)
+		for (int32 i = 1; i < RemainingTrees.Num(); ++i)
 		{
-			if (Formatter == LeftMostNodeTree)
+			FBAFormatAllTree* Tree = RemainingTrees[i];
+			if (Tree->Bounds.Left < ColumnRight)
 			{
-				continue;
-			}
-
-			TSet<UEdGraphNode*> FormatterNodes = Formatter->GetFormattedNodes();
-			FSlateRect Bounds = GetDefault<UBASettings>()->bApplyCommentPadding
-				? FBAUtils::GetCachedNodeArrayBoundsWithComments(AsShared(), Formatter->GetCommentHandler(), Formatter->GetFormattedNodes().Array())
-				: FBAUtils::GetCachedNodeArrayBounds(AsShared(), Formatter->GetFormattedNodes().Array());
-			
-			if (Bounds.Left < ColumnRight)
-			{
-				ColumnRight = FMath::Max(ColumnRight, ColumnX + Bounds.GetSize().X);
-				CurrentColumn.Add(Formatter);
+				ColumnRight = FMath::Max(ColumnRight, ColumnX + Tree->Bounds.GetSize().X);
+				CurrentColumn.Add(Tree);
 			}
 		}
 
-		FSlateRect FormattedBounds;
+		// remove the placed trees before they move
+		const TSet<FBAFormatAllTree*> PlacedTrees(CurrentColumn);
+		RemainingTrees.RemoveAll([&PlacedTrees](FBAFormatAllTree* Tree) { return PlacedTrees.Contains(Tree); });
 
 		// Sort the column by height
-		CurrentColumn.Sort([](TSharedPtr<FFormatterInterface> FormatterA, TSharedPtr<FFormatterInterface> FormatterB)
+		CurrentColumn.StableSort([](const FBAFormatAllTree& TreeA, const FBAFormatAllTree& TreeB)
 		{
-			UEdGraphNode* RootA = FormatterA->GetRootNode();
-			UEdGraphNode* RootB = FormatterB->GetRootNode();
-			if (RootA->NodePosY != RootB->NodePosY)
+			if (TreeA.RootPosition.Y != TreeB.RootPosition.Y)
 			{
-				return RootA->NodePosY < RootB->NodePosY;
+				return TreeA.RootPosition.Y < TreeB.RootPosition.Y;
 			}
 
-			return RootA->NodePosX < RootB->NodePosX;
+			return TreeA.RootPosition.X < TreeB.RootPosition.X;
 		});
 
-		bool bFirst = true;
-
 		// position the node-trees into columns
-		for (TSharedPtr<FFormatterInterface> Formatter : CurrentColumn)
-		{
-			FSlateRect CurrentBounds = GetDefault<UBASettings>()->bApplyCommentPadding
-				? FBAUtils::GetCachedNodeArrayBoundsWithComments(AsShared(), Formatter->GetCommentHandler(), Formatter->GetFormattedNodes().Array())
-				: FBAUtils::GetCachedNodeArrayBounds(AsShared(), Formatter->GetFormattedNodes().Array());
+		StackFormatAllColumn(CurrentColumn, ColumnX);
 
-			// align the position of the formatted nodes to the column
-			const int32 DeltaX = ColumnX - CurrentBounds.Left;
+		ColumnX = ColumnRight + GetDefault<UBASettings>()->FormatAllPadding.X;
+	}
 
-			// offset the first formatted node's Y position to zero
-			const int32 DeltaY = bFirst ? 0 - CurrentBounds.Top : 0;
+	ApplyFormatAllTrees(Trees);
 
-			for (auto FormattedNode : Formatter->GetFormattedNodes())
-			{
-				FormattedNode->NodePosX += DeltaX;
-				FormattedNode->NodePosY += DeltaY;
-			}
+	FormatAllColumns.Empty();
+	FormatAllTransaction.Reset();
+}
 
-			CurrentBounds = GetDefault<UBASettings>()->bApplyCommentPadding
-				? FBAUtils::GetCachedNodeArrayBoundsWithComments(AsShared(), Formatter->GetCommentHandler(), Formatter->GetFormattedNodes().Array())
-				: FBAUtils::GetCachedNodeArrayBounds(AsShared(), Formatter->GetFormattedNodes().Array());
-			
-			if (bFirst)
-			{
-				bFirst = false;
-				FormattedBounds = CurrentBounds;
-			}
-			else
-			{
-				const float Delta = (FormattedBounds.Bottom + GetDefault<UBASettings>()->FormatAllPadding.Y) - CurrentBounds.Top;
-				for (UEdGraphNode* FormattedNode : Formatter->GetFormattedNodes())
-				{
-					FormattedNode->NodePosY += Delta;
-				}
+FBAGraphHandler::FBAFormatAllTree FBAGraphHandler::MakeFormatAllTree(TSharedPtr<FFormatterInterface> Formatter)
+{
+	FBAFormatAllTree Tree;
+	Tree.Formatter = Formatter;
+	Tree.Nodes = Formatter->GetFormattedNodes().Array();
 
-				CurrentBounds = GetDefault<UBASettings>()->bApplyCommentPadding
-					? FBAUtils::GetCachedNodeArrayBoundsWithComments(AsShared(), Formatter->GetCommentHandler(), Formatter->GetFormattedNodes().Array())
-					: FBAUtils::GetCachedNodeArrayBounds(AsShared(), Formatter->GetFormattedNodes().Array());
+	Tree.Bounds = GetDefault<UBASettings>()->bApplyCommentPadding
+		? FBAUtils::GetCachedNodeArrayBoundsWithComments(AsShared(), Formatter->GetCommentHandler(), Tree.Nodes)
+		: FBAUtils::GetCachedNodeArrayBounds(AsShared(), Tree.Nodes);
 
-				FormattedBounds = FormattedBounds.Expand(CurrentBounds);
-			}
+	UEdGraphNode* RootNode = Formatter->GetRootNode();
+	Tree.RootPosition = FIntPoint(RootNode->NodePosX, RootNode->NodePosY);
+
+	return Tree;
+}
+
+FSlateRect FBAGraphHandler::StackFormatAllColumn(const TArray<FBAFormatAllTree*>& Column, int32 ColumnX)
+{
+	FSlateRect FormattedBounds;
+
+	bool bFirst = true;
 
-			// UE_LOG(LogBlueprintAssist, Warning, TEXT("\t%s"), *FBAUtils::GetNodeName(Formatter->GetRootNode()));
-			AllFormatters.Remove(Formatter);
+	for (FBAFormatAllTree* Tree : Column)
+	{
+		// align the position of the formatted nodes to the column
+		const int32 DeltaX = ColumnX - Tree->Bounds.Left;
+
+		// offset the first formatted node's Y position to zero
+		const int32 DeltaY = bFirst ? 0 - Tree->Bounds.Top : 0;
+
+		Tree->Move(FIntPoint(DeltaX, DeltaY));
+
+		if (bFirst)
+		{
+			bFirst = false;
+			FormattedBounds = Tree->Bounds;
 		}
+		else
+		{
+			const int32 Delta = (FormattedBounds.Bottom + GetDefault<UBASettings>()->FormatAllPadding.Y) - Tree->Bounds.Top;
+			Tree->Move(FIntPoint(0, Delta));
 
-		ColumnX = ColumnRight + GetDefault<UBASettings>()->FormatAllPadding.X;
+			FormattedBounds = FormattedBounds.Expand(Tree->Bounds);
+		}
 	}
 
-	FormatAllColumns.Empty();
-	FormatAllTransaction.Reset();
+	return FormattedBounds;
+}
+
+void FBAGraphHandler::ApplyFormatAllTrees(const TArray<FBAFormatAllTree>& Trees)
+{
+	for (const FBAFormatAllTree& Tree : Trees)
+	{
+		if (Tree.Offset == FIntPoint::ZeroValue)
+		{
+			continue;
+		}
+
+		for (UEdGraphNode* Node : Tree.Nodes)
+		{
+			Node->Modify();
+			Node->NodePosX += Tree.Offset.X;
+			Node->NodePosY += Tree.Offset.Y;
+		}
+	}
 }
 
 void FBAGraphHandler::SetSelectedPin(UEdGraphPin* NewPin)
@@ -2356,7 +2429,11 @@ void FBAGraphHandler::RefreshNodeSize(UEdGraphNode* Node)
 
 	if (FBAUtils::IsGraphNode(Node))
 	{
-		GetGraphCache().CachedNodes.Remove(Node->NodeGuid);
+		if (GetGraphCache().CachedNodes.Remove(Node->NodeGuid) > 0)
+		{
+			FBASizeCache::Get().MarkGraphDirty(GetFocusedEdGraph());
+		}
+
 		PendingSize.Add(Node);
 
 		UEdGraphNode* NodeToFormat = GetRootNode(Node, TArray<UEdGraphNode*>());
@@ -2531,6 +2608,7 @@ int32 FBAGraphHandler::GetNumberOfPendingNodesToCache() const
 void FBAGraphHandler::ClearCache()
 {
 	PendingSize.Reset();
+	OffscreenSizeFailed.Reset();
 	PendingFormatting.Reset();
 	DelayedViewportZoomIn.Cancel();
 	DelayedCacheSizeTimeout.Cancel();
@@ -2611,6 +2689,7 @@ TSharedPtr<FFormatterInterface> FBAGraphHandler::FormatNodes(UEdGraphNode* Node,
 void FBAGraphHandler::CancelProcessingNodeSizes()
 {
 	PendingSize.Reset();
+	OffscreenSizeFailed.Reset();
 	PendingFormatting.Reset();
 
 	if (bFullyZoomed)
@@ -2687,8 +2766,101 @@ bool FBAGraphHandler::CacheNodeSize(UEdGraphNode* Node)
 
 		NodeData.CachedNodeSize = Size;
 		GetGraphCache().CachedNodes.Add(Node->NodeGuid, NodeData);
+		FBASizeCache::Get().MarkGraphDirty(GetFocusedEdGraph());
 		return true;
 	}
 
 	return false;
-}
\ No newline at end of file
+}
+
+void FBAGraphHandler::CacheNodeSizesOffscreen(const TArray<UEdGraphNode*>& Nodes, TArray<UEdGraphNode*>& OutCachedNodes)
+{
+	for (UEdGraphNode* Node : Nodes)
+	{
+		// comment nodes are sized by their contents in the graph, so they still need to be measured in the viewport
+		if (FBAUtils::IsCommentNode(Node) || OffscreenSizeFailed.Contains(Node))
+		{
+			continue;
+		}
+
+		if (CacheNodeSizeOffscreen(Node))
+		{
+			OutCachedNodes.Add(Node);
+		}
+		else
+		{
+			OffscreenSizeFailed.Add(Node);
+		}
+	}
+
+	// Complete the size timeout notification
+	if (OutCachedNodes.Num() > 0 && SizeTimeoutNotification.IsValid())
+	{
+		SizeTimeoutNotification.Pin()->SetText(FText::FromString("Successfully calculated size"));
+		SizeTimeoutNotification.Pin()->ExpireAndFadeout();
+		SizeTimeoutNotification.Pin()->SetCompletionState(SNotificationItem::CS_Success);
+	}
+}
+
+bool FBAGraphHandler::CacheNodeSizeOffscreen(UEdGraphNode* Node)
+{
+	// set each node to the global resize comment bubble setting
+	Node->bCommentBubblePinned = GetMutableDefault<UBASettings>()->bSetAllCommentBubblePinned;
+
+	// build the same widget the graph panel would, without adding it to the panel
+	TSharedPtr<SGraphNode> GraphNode = FNodeFactory::CreateNodeWidget(Node);
+	if (!GraphNode.IsValid())
+	{
+		return false;
+	}
+
+	GraphNode->SlatePrepass(1.0f);
+
+	const FVector2D Size = GraphNode->GetDesiredSize();
+
+	// the size can be zero when a node is initially created, do not use this value
+	if (Size.SizeSquared() <= 0)
+	{
+		return false;
+	}
+
+	// arrange the node at the origin to find where its pins are
+	TArray<TSharedRef<SWidget>> PinsAsWidgets;
+	GraphNode->GetPins(PinsAsWidgets);
+
+	TMap<TSharedRef<SWidget>, FArrangedWidget> PinGeometries;
+	GraphNode->FindChildGeometries(FGeometry::MakeRoot(Size, FSlateLayoutTransform()), TSet<TSharedRef<SWidget>>(PinsAsWidgets), PinGeometries);
+
+	FBANodeData NodeData;
+	for (const TSharedRef<SWidget>& Widget : PinsAsWidgets)
+	{
+		UEdGraphPin* Pin = StaticCastSharedRef<SGraphPin>(Widget)->GetPinObj();
+		if (!Pin)
+		{
+			return false;
+		}
+
+		// matches SGraphPin::GetNodeOffset, the center of the pin relative to the top of the node
+		// hidden pins are never arranged and keep a zero offset, the same as in the viewport
+		float PinOffset = 0.f;
+		if (const FArrangedWidget* PinGeometry = PinGeometries.Find(Widget))
+		{
+			PinOffset = PinGeometry->Geometry.AbsolutePosition.Y + PinGeometry->Geometry.GetLocalSize().Y * 0.5f;
+		}
+
+		NodeData.CachedPins.Add(Pin->PinId, PinOffset);
+	}
+
+	if (!Node->IsAutomaticallyPlacedGhostNode())
+	{
+		if (SNodePanel::SNode::FNodeSlot* CommentSlot = GraphNode->GetSlot(ENodeZone::TopCenter))
+		{
+			CommentBubbleSizeCache.Add(Node, CommentSlot->GetWidget()->GetDesiredSize());
+		}
+	}
+
+	NodeData.CachedNodeSize = Size;
+	GetGraphCache().CachedNodes.Add(Node->NodeGuid, NodeData);
+	FBASizeCache::Get().MarkGraphDirty(GetFocusedEdGraph());
+	return true;
+}
@@ -31,6 +31,7 @@ UBASettings::UBASettings(const FObjectInitializer& ObjectInitializer)
 	ShiftCameraDistance = 400.0f;
 
 	bSaveBlueprintAssistCacheToFile = true;
+	SizeCacheSaveInterval = 30.0f;
 
 	bAddToolbarWidget = true;
 
@@ -174,6 +175,8 @@ UBASettings::UBASettings(const FObjectInitializer& ObjectInitializer)
 
 	bSlowButAccurateSizeCaching = false;
 
+	bOffscreenSizeCaching = true;
+
 	bApplyCommentPadding = false;
 
 	KnotNodeDistanceThreshold = 800.f;
@@ -310,8 +313,8 @@ void FBASettingsDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuilder)
 			+ SHorizontalBox::Slot().Padding(5).AutoWidth()
 			[
 				SNew(SButton)
-				.Text(FText::FromString("Delete size cache file"))
-				.ToolTipText(FText::FromString(FString::Printf(TEXT("Delete size cache file located at: %s"), *CachePath)))
+				.Text(FText::FromString("Delete size cache files"))
+				.ToolTipText(FText::FromString(FString::Printf(TEXT("Delete size cache files located at: %s"), *CachePath)))
 				.OnClicked_Lambda(DeleteSizeCache)
 			]
 		];
@@ -7,17 +7,135 @@
 #include "BlueprintAssistSettings.h"
 #include "AssetRegistry/Public/AssetRegistryModule.h"
 #include "AssetRegistry/Public/AssetRegistryState.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
 #include "Core/Public/HAL/PlatformFilemanager.h"
 #include "Core/Public/Misc/CoreDelegates.h"
 #include "Core/Public/Misc/FileHelper.h"
+#include "Core/Public/Misc/Paths.h"
+#include "HAL/FileManager.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "EngineSettings/Classes/GeneralProjectSettings.h"
 #include "JsonUtilities/Public/JsonObjectConverter.h"
 #include "Misc/LazySingleton.h"
 #include "Projects/Public/Interfaces/IPluginManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
-#define CACHE_VERSION 1
+// version 1 was the json format, the binary format starts at version 2
+#define CACHE_VERSION 2
+#define CACHE_VERSION_JSON 1
+
+#define CACHE_FILE_MAGIC 0x43534142 // "BASC"
+
+namespace BASizeCacheFormat
+{
+	void WriteGraphData(FArchive& Ar, const FBAGraphData& GraphData)
+	{
+		int32 NumGraphs = GraphData.GraphCache.Num();
+		Ar << NumGraphs;
+
+		TArray<FGuid> PinIds;
+		TArray<float> PinOffsets;
+
+		for (const TPair<FGuid, FBACacheData>& GraphPair : GraphData.GraphCache)
+		{
+			FGuid GraphGuid = GraphPair.Key;
+			Ar << GraphGuid;
+
+			int32 NumNodes = GraphPair.Value.CachedNodes.Num();
+			Ar << NumNodes;
+
+			for (const TPair<FGuid, FBANodeData>& NodePair : GraphPair.Value.CachedNodes)
+			{
+				FGuid NodeGuid = NodePair.Key;
+				FVector2D NodeSize = NodePair.Value.CachedNodeSize;
+				Ar << NodeGuid;
+				Ar << NodeSize;
+
+				// pins are packed into parallel arrays so the offsets are written as one block
+				NodePair.Value.CachedPins.GenerateKeyArray(PinIds);
+				NodePair.Value.CachedPins.GenerateValueArray(PinOffsets);
+				Ar << PinIds;
+				Ar << PinOffsets;
+			}
+		}
+	}
+
+	bool ReadGraphData(FArchive& Ar, FBAGraphData& OutGraphData)
+	{
+		int32 NumGraphs = 0;
+		Ar << NumGraphs;
+
+		TArray<FGuid> PinIds;
+		TArray<float> PinOffsets;
+
+		for (int32 GraphIndex = 0; GraphIndex < NumGraphs && !Ar.IsError(); ++GraphIndex)
+		{
+			FGuid GraphGuid;
+			int32 NumNodes = 0;
+			Ar << GraphGuid;
+			Ar << NumNodes;
+
+			FBACacheData& CacheData = OutGraphData.GraphCache.FindOrAdd(GraphGuid);
+			for (int32 NodeIndex = 0; NodeIndex < NumNodes && !Ar.IsError(); ++NodeIndex)
+			{
+				FGuid NodeGuid;
+				FBANodeData NodeData;
+				Ar << NodeGuid;
+				Ar << NodeData.CachedNodeSize;
+				Ar << PinIds;
+				Ar << PinOffsets;
+
+				if (PinIds.Num() != PinOffsets.Num())
+				{
+					Ar.SetError();
+					break;
+				}
+
+				NodeData.CachedPins.Reserve(PinIds.Num());
+				for (int32 PinIndex = 0; PinIndex < PinIds.Num(); ++PinIndex)
+				{
+					NodeData.CachedPins.Add(PinIds[PinIndex], PinOffsets[PinIndex]);
+				}
+
+				CacheData.CachedNodes.Add(NodeGuid, MoveTemp(NodeData));
+			}
+		}
+
+		return !Ar.IsError();
+	}
+
+	void WriteShard(const FBAGraphData& GraphData, TArray<uint8>& OutBytes)
+	{
+		FMemoryWriter Writer(OutBytes);
+
+		uint32 Magic = CACHE_FILE_MAGIC;
+		int32 Version = CACHE_VERSION;
+		Writer << Magic;
+		Writer << Version;
+
+		WriteGraphData(Writer, GraphData);
+	}
+
+	bool ReadShard(const TArray<uint8>& Bytes, FBAGraphData& OutGraphData)
+	{
+		FMemoryReader Reader(Bytes);
+
+		uint32 Magic = 0;
+		int32 Version = 0;
+		Reader << Magic;
+		Reader << Version;
+
+		if (Reader.IsError() || Magic != CACHE_FILE_MAGIC || Version != CACHE_VERSION)
+		{
+			return false;
+		}
+
+		return ReadGraphData(Reader, OutGraphData);
+	}
+}
 
 FBASizeCache& FBASizeCache::Get()
 {
@@ -32,7 +150,10 @@ void FBASizeCache::Init()
 		LoadCache();
 	});
 
-	FCoreDelegates::OnPreExit.AddRaw(this, &FBASizeCache::SaveCache);
+	FCoreDelegates::OnPreExit.AddRaw(this, &FBASizeCache::OnPreExit);
+
+	// check once a second, the interval is read from the settings each time so changes apply immediately
+	AutoSaveHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FBASizeCache::TickAutoSave), 1.0f);
 }
 
 void FBASizeCache::LoadCache()
@@ -42,62 +163,93 @@ void FBASizeCache::LoadCache()
 		return;
 	}
 
-	const auto CachePath = GetCachePath();
+	MigrateLegacyCache();
 
-	if (FPlatformFileManager::Get().GetPlatformFile().FileExists(*CachePath))
-	{
-		FString FileData;
-		FFileHelper::LoadFileToString(FileData, *CachePath);
+	CleanupFiles();
+}
 
-		if (FJsonObjectConverter::JsonObjectStringToUStruct(FileData, &PackageData, 0, 0))
-		{
-			UE_LOG(LogBlueprintAssist, Log, TEXT("Loaded blueprint assist node size cache: %s"), *CachePath);
-		}
-		else
-		{
-			UE_LOG(LogBlueprintAssist, Log, TEXT("Failed to load node size cache: %s"), *CachePath);
-		}
+void FBASizeCache::SaveCache()
+{
+	if (!GetDefault<UBASettings>()->bSaveBlueprintAssistCacheToFile)
+	{
+		return;
 	}
 
-	if (PackageData.CacheVersion != CACHE_VERSION)
-	{
-		// clear the cache if our version doesn't match
-		PackageData.PackageCache.Empty();
+	WaitForPendingSave();
+
+	TArray<FShardWrite> Writes;
+	GatherDirtyShards(Writes);
 
-		PackageData.CacheVersion = CACHE_VERSION;
+	for (const FShardWrite& Write : Writes)
+	{
+		WriteShard(Write);
 	}
 
-	CleanupFiles();
+	if (Writes.Num() > 0)
+	{
+		UE_LOG(LogBlueprintAssist, Log, TEXT("Saved node cache for %d packages to %s"), Writes.Num(), *GetCachePath());
+	}
 }
 
-void FBASizeCache::SaveCache()
+void FBASizeCache::SaveCacheAsync()
 {
 	if (!GetDefault<UBASettings>()->bSaveBlueprintAssistCacheToFile)
 	{
 		return;
 	}
 
-	const auto CachePath = GetCachePath();
+	if (PendingSave.IsValid() && !PendingSave.IsReady())
+	{
+		return;
+	}
+
+	TArray<FShardWrite> Writes;
+	GatherDirtyShards(Writes);
+
+	if (Writes.Num() == 0)
+	{
+		return;
+	}
+
+	PendingSave = Async(EAsyncExecution::ThreadPool, [Writes = MoveTemp(Writes)]()
+	{
+		for (const FShardWrite& Write : Writes)
+		{
+			WriteShard(Write);
+		}
+	});
+}
 
-	// Write data to file
-	FString JsonAsString;
-	FJsonObjectConverter::UStructToJsonObjectString(PackageData, JsonAsString);
-	FFileHelper::SaveStringToFile(JsonAsString, *CachePath);
-	UE_LOG(LogBlueprintAssist, Log, TEXT("Saved node cache to %s"), *CachePath);
+void FBASizeCache::WaitForPendingSave()
+{
+	if (PendingSave.IsValid())
+	{
+		PendingSave.Wait();
+		PendingSave.Reset();
+	}
 }
 
 void FBASizeCache::DeleteCache()
 {
+	WaitForPendingSave();
+
 	FString CachePath = GetCachePath();
 	PackageData.PackageCache.Empty();
+	DirtyPackages.Empty();
+
+	// everything was removed from disk, so there is nothing left to load
+	LoadedPackages.Empty();
 
-	if (FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*CachePath))
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.DeleteFile(*GetLegacyCachePath());
+
+	if (PlatformFile.DeleteDirectoryRecursively(*CachePath))
 	{
-		UE_LOG(LogBlueprintAssist, Log, TEXT("Deleted cache file at %s"), *CachePath);
+		UE_LOG(LogBlueprintAssist, Log, TEXT("Deleted cache files at %s"), *CachePath);
 	}
 	else
 	{
-		UE_LOG(LogBlueprintAssist, Log, TEXT("Delete cache failed: Cache file does not exist or is read-only %s"), *CachePath);
+		UE_LOG(LogBlueprintAssist, Log, TEXT("Delete cache failed: Cache directory does not exist or is read-only %s"), *CachePath);
 	}
 }
 
@@ -115,14 +267,54 @@ void FBASizeCache::CleanupFiles()
 		CurrentPackageNames.Add(AssetData->PackageName);
 	}
 
-	// Remove missing files
-	TArray<FName> OldPackageGuids;
-	PackageData.PackageCache.GetKeys(OldPackageGuids);
-	for (FName PackageGuid : OldPackageGuids)
+	// Remove missing packages which have already been loaded
+	TArray<FName> OldPackageNames;
+	PackageData.PackageCache.GetKeys(OldPackageNames);
+	for (FName PackageName : OldPackageNames)
 	{
-		if (!CurrentPackageNames.Contains(PackageGuid))
+		if (!CurrentPackageNames.Contains(PackageName))
 		{
-			PackageData.PackageCache.Remove(PackageGuid);
+			PackageData.PackageCache.Remove(PackageName);
+			DirtyPackages.Remove(PackageName);
+		}
+	}
+
+	// Remove shard files of missing packages (and temp files left by an interrupted write)
+	WaitForPendingSave();
+
+	const FString CachePath = GetCachePath();
+	TArray<FString> ShardFiles;
+	IFileManager::Get().FindFilesRecursive(ShardFiles, *CachePath, TEXT("*.*"), true, false);
+
+	for (const FString& ShardFile : ShardFiles)
+	{
+		FString RelativePath = ShardFile;
+		FPaths::MakePathRelativeTo(RelativePath, *(CachePath / TEXT("")));
+
+		// temp files belong to the package of the shard they replace
+		const bool bTempFile = RelativePath.EndsWith(TEXT(".tmp"));
+		if (bTempFile)
+		{
+			RelativePath.LeftChopInline(4);
+		}
+
+		const FName PackageName(*(TEXT("/") + FPaths::ChangeExtension(RelativePath, TEXT(""))));
+		if (!CurrentPackageNames.Contains(PackageName))
+		{
+			IFileManager::Get().Delete(*ShardFile);
+		}
+		else if (bTempFile)
+		{
+			// a temp file without its shard is a finished write interrupted while replacing the shard, keep it as the shard
+			const FString TargetPath = ShardFile.LeftChop(4);
+			if (IFileManager::Get().FileExists(*TargetPath))
+			{
+				IFileManager::Get().Delete(*ShardFile);
+			}
+			else
+			{
+				IFileManager::Get().Move(*TargetPath, *ShardFile, false, true);
+			}
 		}
 	}
 }
@@ -131,11 +323,25 @@ FBACacheData& FBASizeCache::GetGraphData(UEdGraph* Graph)
 {
 	UPackage* Package = Graph->GetOutermost();
 
-	FBAGraphData& CacheData = PackageData.PackageCache.FindOrAdd(Package->GetFName());
+	const FName PackageName = Package->GetFName();
+	if (!LoadedPackages.Contains(PackageName))
+	{
+		LoadPackage(PackageName);
+	}
+
+	FBAGraphData& CacheData = PackageData.PackageCache.FindOrAdd(PackageName);
 
 	return CacheData.GraphCache.FindOrAdd(Graph->GraphGuid);
 }
 
+void FBASizeCache::MarkGraphDirty(UEdGraph* Graph)
+{
+	if (Graph)
+	{
+		DirtyPackages.Add(Graph->GetOutermost()->GetFName());
+	}
+}
+
 FString FBASizeCache::GetCachePath()
 {
 	const FString PluginDir = IPluginManager::Get().FindPlugin("BlueprintAssist")->GetBaseDir();
@@ -143,17 +349,232 @@ FString FBASizeCache::GetCachePath()
 	const UGeneralProjectSettings* ProjectSettings = GetDefault<UGeneralProjectSettings>();
 	const FGuid& ProjectID = ProjectSettings->ProjectID;
 
-	return PluginDir + "/NodeSizeCache/" + ProjectID.ToString() + ".json";
+	return PluginDir + "/NodeSizeCache/" + ProjectID.ToString();
 }
 
-void FBACacheData::CleanupGraph(UEdGraph* Graph)
+FString FBASizeCache::GetShardPath(FName PackageName)
+{
+	// package names are already valid paths (e.g. /Game/Folder/Asset) so mirror them under the cache directory
+	return GetCachePath() + PackageName.ToString() + ".bacache";
+}
+
+FString FBASizeCache::GetJsonShardPath(FName PackageName)
+{
+	return GetCachePath() + PackageName.ToString() + ".json";
+}
+
+void FBASizeCache::LoadPackage(FName PackageName)
+{
+	LoadedPackages.Add(PackageName);
+
+	if (!GetDefault<UBASettings>()->bSaveBlueprintAssistCacheToFile)
+	{
+		return;
+	}
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	FBAGraphData LoadedData;
+
+	const FString ShardPath = GetShardPath(PackageName);
+	const FString JsonShardPath = GetJsonShardPath(PackageName);
+
+	// replacing a shard deletes it before the temp file is renamed, recover the temp file if that was interrupted
+	const FString TempShardPath = ShardPath + TEXT(".tmp");
+	if (!PlatformFile.FileExists(*ShardPath) && PlatformFile.FileExists(*TempShardPath))
+	{
+		WaitForPendingSave();
+		if (!PlatformFile.FileExists(*ShardPath) && PlatformFile.FileExists(*TempShardPath))
+		{
+			PlatformFile.MoveFile(*ShardPath, *TempShardPath);
+		}
+	}
+
+	if (PlatformFile.FileExists(*ShardPath))
+	{
+		TArray<uint8> FileData;
+		if (!FFileHelper::LoadFileToArray(FileData, *ShardPath) || !BASizeCacheFormat::ReadShard(FileData, LoadedData))
+		{
+			// old version or corrupt, it will be replaced on the next save
+			UE_LOG(LogBlueprintAssist, Log, TEXT("Failed to load node size cache: %s"), *ShardPath);
+			return;
+		}
+	}
+	else if (PlatformFile.FileExists(*JsonShardPath))
+	{
+		FString FileData;
+		FFileHelper::LoadFileToString(FileData, *JsonShardPath);
+
+		FBAPackageShard Shard;
+		if (!FJsonObjectConverter::JsonObjectStringToUStruct(FileData, &Shard, 0, 0) || Shard.CacheVersion != CACHE_VERSION_JSON)
+		{
+			UE_LOG(LogBlueprintAssist, Log, TEXT("Failed to load node size cache: %s"), *JsonShardPath);
+			return;
+		}
+
+		// rewrite the shard in the binary format on the next save
+		LoadedData = MoveTemp(Shard.GraphData);
+		DirtyPackages.Add(PackageName);
+	}
+	else
+	{
+		return;
+	}
+
+	FBAGraphData& GraphData = PackageData.PackageCache.FindOrAdd(PackageName);
+
+	// keep any sizes cached before the shard was loaded
+	for (TPair<FGuid, FBACacheData>& GraphPair : LoadedData.GraphCache)
+	{
+		if (!GraphData.GraphCache.Contains(GraphPair.Key))
+		{
+			GraphData.GraphCache.Add(GraphPair.Key, MoveTemp(GraphPair.Value));
+		}
+	}
+}
+
+void FBASizeCache::GatherDirtyShards(TArray<FShardWrite>& OutWrites)
+{
+	OutWrites.Reserve(DirtyPackages.Num());
+
+	for (FName PackageName : DirtyPackages)
+	{
+		FShardWrite& Write = OutWrites.AddDefaulted_GetRef();
+		Write.ShardPath = GetShardPath(PackageName);
+		Write.JsonShardPath = GetJsonShardPath(PackageName);
+
+		if (const FBAGraphData* GraphData = PackageData.PackageCache.Find(PackageName))
+		{
+			Write.GraphData = *GraphData;
+		}
+	}
+
+	DirtyPackages.Empty();
+}
+
+void FBASizeCache::WriteShard(const FShardWrite& Write)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// the binary shard replaces any json shard from an older version
+	PlatformFile.DeleteFile(*Write.JsonShardPath);
+
+	if (Write.GraphData.GraphCache.Num() == 0)
+	{
+		PlatformFile.DeleteFile(*Write.ShardPath);
+		return;
+	}
+
+	TArray<uint8> FileData;
+	BASizeCacheFormat::WriteShard(Write.GraphData, FileData);
+
+	// write to a temp file first so a crash mid-write never leaves a partial shard behind. Replacing deletes the shard
+	// before renaming, if that is interrupted the temp file is recovered by LoadPackage or CleanupFiles.
+	const FString TempPath = Write.ShardPath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(FileData, *TempPath) || !IFileManager::Get().Move(*Write.ShardPath, *TempPath, true, true))
+	{
+		IFileManager::Get().Delete(*TempPath);
+		UE_LOG(LogBlueprintAssist, Warning, TEXT("Failed to save node size cache: %s"), *Write.ShardPath);
+	}
+}
+
+bool FBASizeCache::TickAutoSave(float DeltaTime)
+{
+	const float SaveInterval = GetDefault<UBASettings>()->SizeCacheSaveInterval;
+	if (SaveInterval <= 0.0f)
+	{
+		return true;
+	}
+
+	TimeSinceSave += DeltaTime;
+	if (TimeSinceSave >= SaveInterval)
+	{
+		TimeSinceSave = 0.0f;
+		SaveCacheAsync();
+	}
+
+	return true;
+}
+
+void FBASizeCache::OnPreExit()
+{
+	FTicker::GetCoreTicker().RemoveTicker(AutoSaveHandle);
+	AutoSaveHandle.Reset();
+
+	// only the packages changed since the last background save are left to write
+	SaveCache();
+}
+
+void FBASizeCache::MigrateLegacyCache()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	const FString LegacyCachePath = GetLegacyCachePath();
+	if (!PlatformFile.FileExists(*LegacyCachePath))
+	{
+		return;
+	}
+
+	FString FileData;
+	FFileHelper::LoadFileToString(FileData, *LegacyCachePath);
+
+	FBAPackageData LegacyData;
+	if (FJsonObjectConverter::JsonObjectStringToUStruct(FileData, &LegacyData, 0, 0) && LegacyData.CacheVersion == CACHE_VERSION_JSON)
+	{
+		for (TPair<FName, FBAGraphData>& PackagePair : LegacyData.PackageCache)
+		{
+			const FName PackageName = PackagePair.Key;
+
+			// packages loaded before the migration keep their graphs and take the legacy graphs they are missing
+			if (LoadedPackages.Contains(PackageName))
+			{
+				FBAGraphData& GraphData = PackageData.PackageCache.FindOrAdd(PackageName);
+
+				bool bAddedAny = false;
+				for (TPair<FGuid, FBACacheData>& GraphPair : PackagePair.Value.GraphCache)
+				{
+					if (!GraphData.GraphCache.Contains(GraphPair.Key))
+					{
+						GraphData.GraphCache.Add(GraphPair.Key, MoveTemp(GraphPair.Value));
+						bAddedAny = true;
+					}
+				}
+
+				if (bAddedAny)
+				{
+					DirtyPackages.Add(PackageName);
+				}
+			}
+			// don't overwrite packages which already have a shard
+			else if (!PlatformFile.FileExists(*GetShardPath(PackageName)) && !PlatformFile.FileExists(*GetJsonShardPath(PackageName)))
+			{
+				PackageData.PackageCache.Add(PackageName, MoveTemp(PackagePair.Value));
+				LoadedPackages.Add(PackageName);
+				DirtyPackages.Add(PackageName);
+			}
+		}
+
+		UE_LOG(LogBlueprintAssist, Log, TEXT("Migrated node size cache %s to %s"), *LegacyCachePath, *GetCachePath());
+	}
+
+	PlatformFile.DeleteFile(*LegacyCachePath);
+}
+
+FString FBASizeCache::GetLegacyCachePath()
+{
+	return GetCachePath() + ".json";
+}
+
+bool FBACacheData::CleanupGraph(UEdGraph* Graph)
 {
 	if (Graph == nullptr)
 	{
 		UE_LOG(LogBlueprintAssist, Error, TEXT("Tried to cleanup null graph"));
-		return;
+		return false;
 	}
 
+	bool bRemovedAny = false;
+
 	TSet<FGuid> CurrentNodes;
 	for (UEdGraphNode* Node : Graph->Nodes)
 	{
@@ -179,6 +600,7 @@ void FBACacheData::CleanupGraph(UEdGraph* Graph)
 				if (!CurrentPins.Contains(PinGuid))
 				{
 					FoundNode->CachedPins.Remove(PinGuid);
+					bRemovedAny = true;
 				}
 			}
 		}
@@ -193,6 +615,9 @@ void FBACacheData::CleanupGraph(UEdGraph* Graph)
 		if (!CurrentNodes.Contains(NodeGuid))
 		{
 			CachedNodes.Remove(NodeGuid);
+			bRemovedAny = true;
 		}
 	}
+
+	return bRemovedAny;
 }
@@ -55,6 +55,9 @@ public:
 
 	TSharedPtr<SDockTab> GetTabForAssetEditor(IAssetEditorInstance* AssetEditor) const;
 
+	/* Handler of an open blueprint, null if the blueprint is not open */
+	FBABlueprintHandler* GetBlueprintHandler(UBlueprint* Blueprint);
+
 protected:
 	void BindAssetOpenedDelegate();
 
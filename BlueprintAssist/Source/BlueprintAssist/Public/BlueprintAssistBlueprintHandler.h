@@ -2,6 +2,9 @@
 
 #pragma once
 
+struct FGoToSymbolStruct;
+struct FEdGraphEditAction;
+
 // TODO: make this a UObject so we don't need to create these structs
 struct FBAVariableMetaDataEntry
 {
@@ -80,7 +83,35 @@ public:
 
 	void DetectGraphIssues(UEdGraph* Graph);
 
+	bool IsBoundTo(UBlueprint* Blueprint) const { return bActive && BlueprintPtr.Get() == Blueprint; }
+
+	/* Symbols listed by the go to symbol menu, only the graphs which changed since the last call are scanned again */
+	const TArray<TSharedPtr<FGoToSymbolStruct>>& GetSymbols();
+
 private:
+	struct FBASymbolGraph
+	{
+		TWeakObjectPtr<UEdGraph> Graph;
+		FDelegateHandle GraphChangedHandle;
+		TArray<TSharedPtr<FGoToSymbolStruct>> Symbols;
+		bool bDirty = true;
+	};
+
+	/* Add and remove graphs from the symbol index to match the blueprint */
+	void UpdateSymbolGraphs(UBlueprint* Blueprint);
+
+	void OnSymbolGraphChanged(const FEdGraphEditAction& Action, TWeakObjectPtr<UEdGraph> Graph);
+
+	void ClearSymbols();
+
+	TArray<FBASymbolGraph> SymbolGraphs;
+
+	TArray<TSharedPtr<FGoToSymbolStruct>> Symbols;
+
+	bool bSymbolGraphsDirty = true;
+
+	bool bSymbolsDirty = true;
+
 	TWeakObjectPtr<UBlueprint> BlueprintPtr;
 
 	TArray<FBAVariableDescription> LastVariables;
@@ -25,6 +25,9 @@ public:
 
 	FBAGraphHandler(TWeakPtr<SDockTab> InTab, TWeakPtr<SGraphEditor> InGraphEditor);
 
+	/* Handler for a graph which is not open in an editor (e.g. from a commandlet), only usable for formatting */
+	explicit FBAGraphHandler(UEdGraph* InGraph);
+
 	~FBAGraphHandler();
 
 	void InitGraphHandler();
@@ -184,14 +187,46 @@ private:
 
 	TArray<UEdGraphNode*> PendingSize;
 
+	/* Nodes which could not be measured offscreen, these fall back to the viewport */
+	TSet<UEdGraphNode*> OffscreenSizeFailed;
+
 	TArray<TArray<UEdGraphNode*>> FormatAllColumns;
+
+	/* A node tree formatted by format all, the layout only moves the bounds and the nodes are moved once at the end */
+	struct FBAFormatAllTree
+	{
+		TSharedPtr<FFormatterInterface> Formatter;
+		TArray<UEdGraphNode*> Nodes;
+		FSlateRect Bounds;
+		FIntPoint RootPosition;
+		FIntPoint Offset = FIntPoint::ZeroValue;
+
+		void Move(const FIntPoint& Delta)
+		{
+			Offset += Delta;
+			Bounds = Bounds.OffsetBy(FVector2D(Delta));
+		}
+	};
+
+	FBAFormatAllTree MakeFormatAllTree(TSharedPtr<FFormatterInterface> Formatter);
+
+	/* Stack the trees from top to bottom with their left edge on ColumnX, returns the bounds of the column */
+	static FSlateRect StackFormatAllColumn(const TArray<FBAFormatAllTree*>& Column, int32 ColumnX);
+
+	static void ApplyFormatAllTrees(const TArray<FBAFormatAllTree>& Trees);
 	TMap<UEdGraphNode*, TSharedPtr<FFormatterInterface>> FormatterMap;
 
 	TSharedPtr<FScopedTransaction> PendingTransaction;
 	TSharedPtr<FScopedTransaction> ReplaceNewNodeTransaction;
 	TSharedPtr<FScopedTransaction> FormatAllTransaction;
 
-	TArray<UEdGraphNode*> LastNodes;
+	TSet<UEdGraphNode*> LastNodes;
+
+	/* Nodes reported as added by graph changed actions since the last call to DetectGraphChanges, minus the ones removed again */
+	TSet<TWeakObjectPtr<UEdGraphNode>> PendingAddedNodes;
+
+	/* Set when a graph change didn't say which nodes changed, so the whole graph must be compared */
+	bool bRescanAllNodes = false;
 
 	FDelegateHandle OnGraphChangedHandle;
 
@@ -224,6 +259,8 @@ private:
 
 	void DetectGraphChanges();
 
+	void ResetLastNodes();
+
 	void OnNodesAdded(const TArray<UEdGraphNode*>& NewNodes);
 
 	void CacheNodeSizes(const TArray<UEdGraphNode*>& Nodes);
@@ -244,6 +281,10 @@ private:
 
 	bool CacheNodeSize(UEdGraphNode* Node);
 
+	void CacheNodeSizesOffscreen(const TArray<UEdGraphNode*>& Nodes, TArray<UEdGraphNode*>& OutCachedNodes);
+
+	bool CacheNodeSizeOffscreen(UEdGraphNode* Node);
+
 	bool UpdateNodeSizesChanges(const TArray<UEdGraphNode*>& Nodes);
 
 	void AutoLerpToNewlyCreatedNode(UEdGraphNode* Node, const FFormatterInterface& Formatter);
@@ -174,10 +174,18 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = General)
 	bool bSlowButAccurateSizeCaching;
 
+	/* Measure node sizes by building the node widgets offscreen instead of moving the viewport to each node. Comment nodes and nodes which fail to measure still use the viewport */
+	UPROPERTY(EditAnywhere, config, Category = General)
+	bool bOffscreenSizeCaching;
+
 	/* Save the node size cache to a file (located in the the plugin folder) */
 	UPROPERTY(EditAnywhere, config, Category = General)
 	bool bSaveBlueprintAssistCacheToFile;
 
+	/* Seconds between background saves of changed node sizes. When 0, the cache is only saved when the editor closes */
+	UPROPERTY(EditAnywhere, config, Category = General, meta = (EditCondition = "bSaveBlueprintAssistCacheToFile", ClampMin = 0))
+	float SizeCacheSaveInterval;
+
 	/* Determines if we should auto zoom to a newly created node */
 	UPROPERTY(EditAnywhere, config, Category = General)
 	EBAAutoZoomToNode AutoZoomToNodeBehavior = EBAAutoZoomToNode::Outside_Viewport;
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 #include "SGraphPin.h"
+#include "Async/Future.h"
 
 #include "BlueprintAssistSizeCache.generated.h"
 
@@ -28,7 +29,8 @@ struct BLUEPRINTASSIST_API FBACacheData
 	UPROPERTY()
 	TMap<FGuid, FBANodeData> CachedNodes;
 
-	void CleanupGraph(UEdGraph* Graph);
+	/* Remove cached nodes and pins which no longer exist in the graph, returns true if anything was removed */
+	bool CleanupGraph(UEdGraph* Graph);
 };
 
 USTRUCT()
@@ -40,6 +42,19 @@ struct BLUEPRINTASSIST_API FBAGraphData
 	TMap<FGuid, FBACacheData> GraphCache;
 };
 
+/* The contents of a single package's shard file in the json format (CACHE_VERSION 1), only read when migrating */
+USTRUCT()
+struct BLUEPRINTASSIST_API FBAPackageShard
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	FBAGraphData GraphData;
+
+	UPROPERTY()
+	int CacheVersion = -1;
+};
+
 USTRUCT()
 struct BLUEPRINTASSIST_API FBAPackageData
 {
@@ -52,6 +67,11 @@ struct BLUEPRINTASSIST_API FBAPackageData
 	int CacheVersion = -1;
 };
 
+/**
+ * Node size cache, stored as one binary shard file per package under <Plugin>/NodeSizeCache/<ProjectID>/.
+ * A package's shard is loaded the first time one of its graphs is requested and only written back if it was marked dirty.
+ * Dirty packages are periodically copied on the game thread and written by a worker thread, each shard replacing the old file once fully written.
+ */
 class BLUEPRINTASSIST_API FBASizeCache
 {
 public:
@@ -61,18 +81,69 @@ public:
 
 	FBAPackageData& GetPackageData() { return PackageData; }
 
+	/* Migrate the legacy single file cache and remove shards of packages which no longer exist */
 	void LoadCache();
 
+	/* Write the shards of all dirty packages, blocking until they are written */
 	void SaveCache();
 
+	/* Write the shards of all dirty packages on a worker thread, does nothing if the previous write is still in progress */
+	void SaveCacheAsync();
+
+	/* Block until the background write has finished */
+	void WaitForPendingSave();
+
 	void DeleteCache();
 
 	void CleanupFiles();
 
 	FBACacheData& GetGraphData(UEdGraph* Graph);
 
+	/* Flag the graph's package so its shard is written on the next save */
+	void MarkGraphDirty(UEdGraph* Graph);
+
+	/* Directory containing the shard files for this project */
 	FString GetCachePath();
 
+	FString GetShardPath(FName PackageName);
+
+	FString GetJsonShardPath(FName PackageName);
+
 private:
+	struct FShardWrite
+	{
+		FString ShardPath;
+		FString JsonShardPath;
+
+		/* Copy of the package's data, the shard is deleted if this is empty */
+		FBAGraphData GraphData;
+	};
+
+	void LoadPackage(FName PackageName);
+
+	/* Copy the data of all dirty packages and clear the dirty flags */
+	void GatherDirtyShards(TArray<FShardWrite>& OutWrites);
+
+	static void WriteShard(const FShardWrite& Write);
+
+	bool TickAutoSave(float DeltaTime);
+
+	void OnPreExit();
+
+	void MigrateLegacyCache();
+
+	FString GetLegacyCachePath();
+
 	FBAPackageData PackageData;
+
+	/* Packages whose shard has been read (or found to be missing) */
+	TSet<FName> LoadedPackages;
+
+	TSet<FName> DirtyPackages;
+
+	TFuture<void> PendingSave;
+
+	FDelegateHandle AutoSaveHandle;
+
+	float TimeSinceSave = 0.0f;
 };
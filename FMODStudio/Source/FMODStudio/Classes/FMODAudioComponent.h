@@ -157,6 +157,9 @@ public:
     UPROPERTY()
     uint32 bAutoDestroy : 1;
 
+    /** Return this component to the audio component pool on completion instead of destroying it. Only applies with bAutoDestroy. */
+    uint32 bPooled : 1;
+
     /** Stop sound when owner is destroyed. */
     UPROPERTY()
     uint32 bStopWhenOwnerDestroyed : 1;
@@ -218,6 +221,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Audio|FMOD|Components")
     void SetParameter(FName Name, float Value);
 
+    /** Set several parameters of the Event in a single call. */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD|Components")
+    void SetParameters(const TMap<FName, float> &Parameters);
+
     /** Will be deprecated in FMOD 2.01, use `GetParameterValue(FName, float, float)` instead.
      * Get parameter value from the Event.
     */
@@ -255,6 +262,9 @@ public:
     /** Called when the event has finished stopping. */
     void OnPlaybackCompleted();
 
+    /** Clear per-playback state so a pooled component can be reused for another event. */
+    void ResetForPool();
+
     /** Update gain and low-pass based on interior volumes. */
     void UpdateInteriorVolumes();
 
@@ -276,9 +286,21 @@ public:
     /** Update attenuation if we have it set. */
     void UpdateAttenuation();
 
+    /** Called with the result of a queued occlusion trace. */
+    void OnOcclusionTraceCompleted(bool bIsOccluded);
+
     /** Apply Volume and LPF into event. */
     void ApplyVolumeLPF();
 
+    /** Update interior volumes, attenuation and the ambient parameters if this component's update interval has passed. */
+    void UpdateSpatialState();
+
+    /** Time at which the next spatial state update is due. */
+    double GetNextSpatialUpdateTime() const { return NextSpatialUpdateTime; }
+
+    /** Time until the next spatial state update, based on the distance to the nearest listener and whether the event can be heard. */
+    float GetSpatialUpdateInterval();
+
     /** Cache default event parameter values. */
     void CacheDefaultParameterValues();
 
@@ -334,6 +356,15 @@ private:
     /** Release the Studio Instance. */
     void ReleaseEventInstance();
 
+    /** Resolve the IDs of the game settable local parameters of the given event description, if they aren't already cached for it. */
+    void CacheParameterIDs(FMOD::Studio::EventDescription *EventDesc);
+
+    /** Look up a cached parameter ID by name. */
+    const FMOD_STUDIO_PARAMETER_ID *FindParameterID(const FName &Name) const { return ParameterIDs.Find(Name); }
+
+    /** Apply parameter values to the Studio Instance, batching the ones with known IDs. */
+    void ApplyParameters(const TMap<FName, float> &Parameters);
+
     /** Return a cached reference to the current IFMODStudioModule.*/
     IFMODStudioModule& GetStudioModule()
     {
@@ -356,10 +387,18 @@ private:
     float LastVolume;
     float LastLPF;
     bool wasOccluded;
+    double NextOcclusionUpdateTime;
+    double NextSpatialUpdateTime;
+    /** A spatial update was skipped by the update interval and still needs to happen. */
+    bool bSpatialUpdatePending;
     FMOD_STUDIO_PARAMETER_ID OcclusionID;
     FMOD_STUDIO_PARAMETER_ID AmbientVolumeID;
     FMOD_STUDIO_PARAMETER_ID AmbientLPFID;
 
+    // Parameter IDs of the event description they were resolved from.
+    FMOD::Studio::EventDescription *ParameterIDsDescription;
+    TMap<FName, FMOD_STUDIO_PARAMETER_ID> ParameterIDs;
+
     // Tempo and marker callbacks.
     FCriticalSection CallbackLock;
     TArray<FTimelineMarkerProperties> CallbackMarkerQueue;
@@ -31,6 +31,8 @@ struct FFMODEventInstance
     FMOD::Studio::EventInstance *Instance;
 };
 
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnFMODAssetFoundDynamic, UFMODAsset *, Asset);
+
 UENUM(BlueprintType)
 enum EFMOD_STUDIO_STOP_MODE
 {
@@ -44,6 +46,7 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
     GENERATED_UCLASS_BODY()
 
     /** Plays an event.  This returns an FMOD Event Instance.  The sound does not travel with any actor.
+	 * When the event instance pool is enabled in the FMOD settings, auto played events may return an empty instance.
 	 * @param Event - event to play
 	 * @param bAutoPlay - Start the event automatically.
 	 */
@@ -53,6 +56,7 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
     static FFMODEventInstance PlayEvent2D(UObject *WorldContextObject, UFMODEvent *Event, bool bAutoPlay);
 
     /** Plays an event at the given location. This returns an FMOD Event Instance.  The sound does not travel with any actor.
+	 * When the event instance pool is enabled in the FMOD settings, auto played events may return an empty instance.
 	 * @param Event - event to play
 	 * @param Location - World position to play event at
 	 * @param bAutoPlay - Start the event automatically.
@@ -70,7 +74,7 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
 	 * @param LocationType - Specifies whether Location is a relative offset or an absolute world position
 	 * @param bStopWhenAttachedToDestroyed - Specifies whether the sound should stop playing when the owner of the attach to component is destroyed.
 	 * @param bAutoPlay - Start the event automatically.
-	 * @param bAutoDestroy - Automatically destroy the audio component when the sound is stopped.
+	 * @param bAutoDestroy - Automatically destroy the audio component when the sound is stopped. If the component is owned by an actor it may instead be returned to the audio component pool and reused, so don't keep a reference to it after it stops.
 	 */
     UFUNCTION(BlueprintCallable, Category = "Audio|FMOD",
         meta = (AdvancedDisplay = "2", UnsafeDuringActorConstruction = "true", bAutoPlay = "true", bAutoDestroy = "true"))
@@ -89,6 +93,19 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
     UFUNCTION(BlueprintCallable, Category = "Audio|FMOD")
     static UFMODEvent *FindEventByName(const FString &Name);
 
+    /** Find an asset by name without blocking while its package loads.
+	 * @param Name - The asset name
+	 * @param OnFound - Called with the asset, or null if it could not be found
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD")
+    static void FindAssetByNameAsync(const FString &Name, FOnFMODAssetFoundDynamic OnFound);
+
+    /** Start loading assets in the background so that finding them later doesn't block.
+	 * @param Names - The asset names
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD")
+    static void PrefetchAssetsByName(const TArray<FString> &Names);
+
     /** Loads a bank.
 	 * @param Bank - bank to load
 	 * @param bBlocking - determines whether the bank will load synchronously
@@ -128,6 +145,13 @@ class FMODSTUDIO_API UFMODBlueprintStatics : public UBlueprintFunctionLibrary
         meta = (HidePin = "WorldContextObject", DefaultToSelf = "WorldContextObject", UnsafeDuringActorConstruction = "true"))
     static void LoadEventSampleData(UObject *WorldContextObject, UFMODEvent *Event);
 
+    /** Create pooled instances of an event ahead of time so one-shots played with Play Event 2D or Play Event At Location
+	 * don't have to create them. Does nothing unless Event Instance Pool Size is set in the FMOD settings.
+	 * @param Event - event to create instances of.
+	 */
+    UFUNCTION(BlueprintCallable, Category = "Audio|FMOD", meta = (UnsafeDuringActorConstruction = "true"))
+    static void PrewarmEventInstances(UFMODEvent *Event);
+
     /** Unload event sample data.
 	 * @param Event - event to load sample data from.
 	 */
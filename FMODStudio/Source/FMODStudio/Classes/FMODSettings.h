@@ -105,6 +105,13 @@ public:
     UPROPERTY(config, EditAnywhere, Category = Basic)
     bool bLoadAllSampleData;
 
+    /**
+	 * Whether to memory map bank files and let FMOD read them in place instead of copying them into its own memory.
+	 * Only applies to banks loaded at startup and falls back to normal file loading if the platform can't map the file.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = Basic)
+    bool bMemoryMapBanks;
+
     /**
 	 * Enable live update in non-final builds.
 	 */
@@ -189,6 +196,22 @@ public:
     UPROPERTY(config, EditAnywhere, Category = InitSettings)
     int32 FileBufferSize;
 
+    /**
+	 * Number of threads used to service FMOD file access (4 by default).
+	 * Each open file is serviced independently, so streams and bank loads don't wait on each other.
+	 * Set to 0 to read directly on the FMOD thread that requested the data.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings, meta = (ClampMin = "0"))
+    int32 FileAccessThreadCount;
+
+    /**
+	 * Whether FMOD should issue asynchronous file reads, letting it keep decoding while data is fetched (off by default).
+	 * Requests are serviced by the file access threads in priority order, so this requires File Access Thread Count to be
+	 * greater than 0 and has no effect otherwise.
+	 */
+    UPROPERTY(config, EditAnywhere, Category = InitSettings)
+    bool bAsyncFileRead;
+
     /**
 	 * Studio update period in milliseconds, or 0 for default (which means 20ms).
 	 */
@@ -296,6 +319,61 @@ public:
     UPROPERTY(config, EditAnywhere, Category = Advanced)
     FString OcclusionParameter;
 
+    /**
+    * Maximum number of occlusion traces issued per frame, or 0 for no limit.
+    * Traces over the budget wait for a later frame, longest waiting first.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 MaxOcclusionTracesPerFrame;
+
+    /**
+    * Time in seconds between occlusion updates for emitters at or beyond the Occlusion Update Distance.
+    * Closer emitters update proportionally more often, down to every frame at the listener.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0.0"))
+    float OcclusionUpdateInterval;
+
+    /**
+    * Distance from the listener at which emitters use the full Occlusion Update Interval.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0.0"))
+    float OcclusionUpdateDistance;
+
+    /**
+    * Time in seconds between interior volume, attenuation and ambient parameter updates for audio components at or beyond the
+    * Spatial Update Distance. Closer components update proportionally more often, down to every frame at the listener.
+    * Virtual events and events beyond their maximum distance always use the full interval. Set to 0 to update every frame,
+    * which is the default.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0.0"))
+    float SpatialUpdateInterval;
+
+    /**
+    * Distance from the nearest listener at which audio components use the full Spatial Update Interval.
+    * Has no effect while the Spatial Update Interval is 0.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0.0"))
+    float SpatialUpdateDistance;
+
+    /**
+    * Maximum number of finished audio components kept per world for reuse by Play Event Attached and the FMOD anim notify.
+    * Only auto-destroying components on an actor are pooled. Set to 0 to disable pooling.
+    * Idle components are only reused by the actor that owns them, so this helps actors that play events repeatedly
+    * rather than many different actors each playing a single event.
+    * A finished component returned by Play Event Attached may be reused for an unrelated event, so only enable this if
+    * callers don't hold on to the returned components.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 AudioComponentPoolSize;
+
+    /**
+    * Maximum number of event instances kept per event for reuse by one-shots played with Play Event 2D and Play Event At Location.
+    * Stopped instances are restarted instead of creating new ones. Set to 0 to disable pooling.
+    * A one-shot played on a pooled instance returns an empty Event Instance, so it can't be controlled after it starts.
+    */
+    UPROPERTY(config, EditAnywhere, Category = Advanced, meta = (ClampMin = "0"))
+    int32 EventInstancePoolSize;
+
     /**
     * Name of the parameter used in Studio to control Ambient volume.
     */
@@ -19,6 +19,29 @@
 #include "Misc/Paths.h"
 #include "UObject/Package.h"
 
+static const TCHAR *NonLocalizedRowName = TEXT("<NON-LOCALIZED>");
+
+FFMODAssetTable::FFMODAssetTable()
+    : BankLookup(nullptr)
+    , AssetLookup(nullptr)
+    , IndexedBankLookup(nullptr)
+    , IndexedAssetLookup(nullptr)
+    , bIndexStale(true)
+    , IndexGeneration(MakeShared<uint32>(0))
+{
+#if WITH_EDITOR
+    // The asset builder regenerates the lookups in place, so watch their packages for changes
+    PackageMarkedDirtyHandle = UPackage::PackageMarkedDirtyEvent.AddRaw(this, &FFMODAssetTable::OnPackageMarkedDirty);
+#endif
+}
+
+FFMODAssetTable::~FFMODAssetTable()
+{
+#if WITH_EDITOR
+    UPackage::PackageMarkedDirtyEvent.Remove(PackageMarkedDirtyHandle);
+#endif
+}
+
 void FFMODAssetTable::AddReferencedObjects(FReferenceCollector& Collector)
 {
     // The garbage collector will clean up any objects which aren't referenced, doing this tells the garbage collector our lookups are referenced
@@ -32,6 +55,11 @@ void FFMODAssetTable::AddReferencedObjects(FReferenceCollector& Collector)
     {
         Collector.AddReferencedObject(AssetLookup);
     }
+
+    for (TPair<FString, UFMODAsset *> &Entry : ResidentAssets)
+    {
+        Collector.AddReferencedObject(Entry.Value);
+    }
 }
 
 void FFMODAssetTable::Load()
@@ -88,49 +116,98 @@ void FFMODAssetTable::Load()
             UE_LOG(LogFMOD, Error, msg);
         }
     }
+
+    if (bIndexStale || BankLookup != IndexedBankLookup || AssetLookup != IndexedAssetLookup)
+    {
+        BuildIndex();
+    }
 }
 
-FString FFMODAssetTable::GetBankPathByGuid(const FGuid& Guid) const
+void FFMODAssetTable::BuildIndex()
 {
-    FString BankPath;
+    const double StartTime = FPlatformTime::Seconds();
 
-    if (!BankLookup)
+    LocalizedBankPaths.Reset();
+    AssetLocations.Reset();
+    ResidentAssets.Reset();
+    ++(*IndexGeneration);
+
+    if (BankLookup && BankLookup->DataTable)
     {
-        UE_LOG(LogFMOD, Error, TEXT("Bank lookup not loaded"));
-        return BankPath;
-    }
+        BankLookup->DataTable->ForeachRow<FFMODLocalizedBankTable>(nullptr, [this](const FName &Key, const FFMODLocalizedBankTable &OuterRow) {
+            FGuid Guid;
+            if (!OuterRow.Banks || !FGuid::Parse(Key.ToString(), Guid))
+            {
+                return;
+            }
 
-    FString GUID = Guid.ToString(EGuidFormats::DigitsWithHyphensInBraces);
-    FName BankTableName(*GUID);
-    FFMODLocalizedBankTable *BankTable = BankLookup->DataTable->FindRow<FFMODLocalizedBankTable>(BankTableName, nullptr, false);
+            TMap<FString, FString> &Paths = LocalizedBankPaths.Add(Guid);
+            OuterRow.Banks->ForeachRow<FFMODLocalizedBankRow>(nullptr, [&Paths](const FName &Locale, const FFMODLocalizedBankRow &Row) {
+                Paths.Add(Locale.ToString(), Row.Path);
+            });
+        });
+    }
 
-    if (BankTable)
+    if (AssetLookup)
     {
-        BankPath = GetLocalizedBankPath(BankTable->Banks);
+        AssetLocations.Reserve(AssetLookup->GetRowMap().Num());
+        AssetLookup->ForeachRow<FFMODAssetLookupRow>(nullptr, [this](const FName &Key, const FFMODAssetLookupRow &Row) {
+            AssetLocations.Add(Key.ToString(), FAssetLocation{ Row.PackageName, Row.AssetName });
+        });
     }
-    
-    return BankPath;
+
+    IndexedBankLookup = BankLookup;
+    IndexedAssetLookup = AssetLookup;
+    bIndexStale = false;
+
+    BuildActiveBankPaths();
+
+    UE_LOG(LogFMOD, Verbose, TEXT("Indexed %d banks and %d assets in %.2f ms"), LocalizedBankPaths.Num(), AssetLocations.Num(),
+        (FPlatformTime::Seconds() - StartTime) * 1000.0);
 }
 
-FString FFMODAssetTable::GetLocalizedBankPath(const UDataTable* BankTable) const
+void FFMODAssetTable::BuildActiveBankPaths()
 {
-    FName RowName(*ActiveLocale);
-    FFMODLocalizedBankRow *Row = BankTable->FindRow<FFMODLocalizedBankRow>(RowName, nullptr, false);
+    ActiveBankPaths.Reset();
+    ActiveBankPaths.Reserve(LocalizedBankPaths.Num());
 
-    if (!Row)
+    for (const TPair<FGuid, TMap<FString, FString>> &Entry : LocalizedBankPaths)
     {
-        RowName = FName("<NON-LOCALIZED>");
-        Row = BankTable->FindRow<FFMODLocalizedBankRow>(RowName, nullptr, false);
+        const FString *Path = Entry.Value.Find(ActiveLocale);
+
+        if (!Path)
+        {
+            Path = Entry.Value.Find(NonLocalizedRowName);
+        }
+
+        if (Path)
+        {
+            ActiveBankPaths.Add(Entry.Key, *Path);
+        }
     }
+}
 
-    FString BankPath;
+#if WITH_EDITOR
+void FFMODAssetTable::OnPackageMarkedDirty(UPackage *Package, bool bWasDirty)
+{
+    if ((IndexedBankLookup && IndexedBankLookup->GetOutermost() == Package) ||
+        (IndexedAssetLookup && IndexedAssetLookup->GetOutermost() == Package))
+    {
+        bIndexStale = true;
+    }
+}
+#endif
 
-    if (Row)
+FString FFMODAssetTable::GetBankPathByGuid(const FGuid& Guid) const
+{
+    if (!BankLookup)
     {
-        BankPath = Row->Path;
+        UE_LOG(LogFMOD, Error, TEXT("Bank lookup not loaded"));
+        return FString();
     }
 
-    return BankPath;
+    const FString *BankPath = ActiveBankPaths.Find(Guid);
+    return BankPath ? *BankPath : FString();
 }
 
 FString FFMODAssetTable::GetBankPath(const UFMODBank &Bank) const
@@ -162,7 +239,11 @@ FString FFMODAssetTable::GetMasterAssetsBankPath() const
 
 void FFMODAssetTable::SetLocale(const FString &LocaleCode)
 {
-    ActiveLocale = LocaleCode;
+    if (ActiveLocale != LocaleCode)
+    {
+        ActiveLocale = LocaleCode;
+        BuildActiveBankPaths();
+    }
 }
 
 FString FFMODAssetTable::GetLocale() const
@@ -175,27 +256,31 @@ void FFMODAssetTable::GetAllBankPaths(TArray<FString> &Paths, bool IncludeMaster
     if (BankLookup)
     {
         const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+        const FString MasterBankFilename = Settings.GetMasterBankFilename();
+        const FString MasterAssetsBankFilename = Settings.GetMasterAssetsBankFilename();
+        const FString MasterStringsBankFilename = Settings.GetMasterStringsBankFilename();
+        const FString FullBankPath = Settings.GetFullBankPath();
 
-        BankLookup->DataTable->ForeachRow<FFMODLocalizedBankTable>(nullptr, [this, &Paths, IncludeMasterBank, &Settings](const FName &, const FFMODLocalizedBankTable& OuterRow) {
-            FString BankPath = GetLocalizedBankPath(OuterRow.Banks);
-            bool Skip = false;
+        Paths.Reserve(Paths.Num() + ActiveBankPaths.Num());
+
+        for (const TPair<FGuid, FString> &Entry : ActiveBankPaths)
+        {
+            const FString &BankPath = Entry.Value;
 
             if (BankPath.IsEmpty())
             {
                 // Never expect to be in here, but should skip empty paths
-                return;
+                continue;
             }
 
-            if (!IncludeMasterBank)
+            if (!IncludeMasterBank &&
+                (BankPath == MasterBankFilename || BankPath == MasterAssetsBankFilename || BankPath == MasterStringsBankFilename))
             {
-                Skip = (BankPath == Settings.GetMasterBankFilename() || BankPath == Settings.GetMasterAssetsBankFilename() || BankPath == Settings.GetMasterStringsBankFilename());
+                continue;
             }
 
-            if (!Skip)
-            {
-                Paths.Push(Settings.GetFullBankPath() / BankPath);
-            }
-        });
+            Paths.Push(FullBankPath / BankPath);
+        }
     }
     else
     {
@@ -203,22 +288,129 @@ void FFMODAssetTable::GetAllBankPaths(TArray<FString> &Paths, bool IncludeMaster
     }
 }
 
-UFMODAsset *FFMODAssetTable::GetAssetByStudioPath(const FString &InStudioPath) const
+UFMODAsset *FFMODAssetTable::FindResidentAsset(const FString &StudioPath, const FAssetLocation &Location)
 {
-    UFMODAsset *Asset = nullptr;
+    UFMODAsset **Cached = ResidentAssets.Find(StudioPath);
+    if (Cached && IsValid(*Cached))
+    {
+        return *Cached;
+    }
 
-    if (AssetLookup)
+    UPackage *Package = FindPackage(nullptr, *(Location.PackageName));
+    UFMODAsset *Asset = (Package && Package->IsFullyLoaded()) ? FindObject<UFMODAsset>(Package, *(Location.AssetName)) : nullptr;
+
+    if (Asset)
+    {
+        ResidentAssets.Add(StudioPath, Asset);
+    }
+
+    return Asset;
+}
+
+UFMODAsset *FFMODAssetTable::GetAssetByStudioPath(const FString &InStudioPath)
+{
+    const FAssetLocation *Location = AssetLocations.Find(InStudioPath);
+
+    if (!Location)
+    {
+        return nullptr;
+    }
+
+    UFMODAsset *Asset = FindResidentAsset(InStudioPath, *Location);
+
+    if (!Asset)
     {
-        FFMODAssetLookupRow *Row = AssetLookup->FindRow<FFMODAssetLookupRow>(FName(*InStudioPath), nullptr);
+        UPackage *Package = CreatePackage(*(Location->PackageName));
+        Package->FullyLoad();
+        Asset = FindObject<UFMODAsset>(Package, *(Location->AssetName));
 
-        if (Row)
+        if (Asset)
         {
-            UPackage *Package = CreatePackage(*(Row->PackageName));
-            Package->FullyLoad();
-            Asset = FindObject<UFMODAsset>(Package, *(Row->AssetName));
+            ResidentAssets.Add(InStudioPath, Asset);
         }
-
     }
 
     return Asset;
 }
+
+void FFMODAssetTable::GetAssetByStudioPathAsync(const FString &InStudioPath, const FOnFMODAssetFound &OnFound)
+{
+    const FAssetLocation *Location = AssetLocations.Find(InStudioPath);
+
+    if (!Location)
+    {
+        OnFound.ExecuteIfBound(nullptr);
+        return;
+    }
+
+    UFMODAsset *Asset = FindResidentAsset(InStudioPath, *Location);
+
+    if (Asset)
+    {
+        OnFound.ExecuteIfBound(Asset);
+        return;
+    }
+
+    // Only the first request for a path starts a load, later ones wait on it
+    TArray<FOnFMODAssetFound> *Pending = PendingAssetLoads.Find(InStudioPath);
+
+    if (Pending)
+    {
+        Pending->Add(OnFound);
+    }
+    else
+    {
+        PendingAssetLoads.Add(InStudioPath).Add(OnFound);
+
+        // The load can outlive the table, only call back into it while it is still alive
+        TWeakPtr<uint32> WeakGeneration = IndexGeneration;
+        const uint32 Generation = *IndexGeneration;
+        LoadPackageAsync(Location->PackageName,
+            FLoadPackageAsyncDelegate::CreateLambda([this, WeakGeneration, Generation, InStudioPath](
+                                                        const FName &PackageName, UPackage *Package, EAsyncLoadingResult::Type Result) {
+                if (WeakGeneration.IsValid())
+                {
+                    OnAssetPackageLoaded(PackageName, Package, Result, InStudioPath, Generation);
+                }
+            }));
+    }
+}
+
+void FFMODAssetTable::OnAssetPackageLoaded(
+    const FName &PackageName, UPackage *Package, EAsyncLoadingResult::Type Result, FString StudioPath, uint32 Generation)
+{
+    TArray<FOnFMODAssetFound> Callbacks;
+    PendingAssetLoads.RemoveAndCopyValue(StudioPath, Callbacks);
+
+    // The index was rebuilt while loading, the asset may live in another package now so look it up again
+    if (Generation != *IndexGeneration)
+    {
+        for (const FOnFMODAssetFound &Callback : Callbacks)
+        {
+            GetAssetByStudioPathAsync(StudioPath, Callback);
+        }
+        return;
+    }
+
+    UFMODAsset *Asset = nullptr;
+    const FAssetLocation *Location = AssetLocations.Find(StudioPath);
+
+    if (Location && Package && Result == EAsyncLoadingResult::Succeeded)
+    {
+        Asset = FindObject<UFMODAsset>(Package, *(Location->AssetName));
+    }
+
+    if (Asset)
+    {
+        ResidentAssets.Add(StudioPath, Asset);
+    }
+    else
+    {
+        UE_LOG(LogFMOD, Warning, TEXT("Failed to load asset %s from package %s"), *StudioPath, *PackageName.ToString());
+    }
+
+    for (const FOnFMODAssetFound &Callback : Callbacks)
+    {
+        Callback.ExecuteIfBound(Asset);
+    }
+}
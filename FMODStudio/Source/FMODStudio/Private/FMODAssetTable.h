@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include "FMODStudioModule.h"
 #include "UObject/GCObject.h"
+#include "UObject/UObjectGlobals.h"
 
 class UDataTable;
 class UFMODAsset;
@@ -12,6 +14,9 @@ class UFMODBankLookup;
 class FFMODAssetTable : public FGCObject
 {
 public:
+    FFMODAssetTable();
+    ~FFMODAssetTable();
+
     //~ FGCObject
     void AddReferencedObjects(FReferenceCollector& Collector) override;
 
@@ -25,17 +30,66 @@ public:
     FString GetLocale() const;
     void GetAllBankPaths(TArray<FString> &BankPaths, bool IncludeMasterBank) const;
 
-    UFMODAsset *GetAssetByStudioPath(const FString &InStudioPath) const;
+    UFMODAsset *GetAssetByStudioPath(const FString &InStudioPath);
+
+    /** Resolve an asset without blocking, calling OnFound once its package has loaded (or immediately if it is resident). */
+    void GetAssetByStudioPathAsync(const FString &InStudioPath, const FOnFMODAssetFound &OnFound);
 
     static inline FString PrivateDataPath() { return FString(TEXT("PrivateIntegrationData/")); }
     static inline FString BankLookupName()  { return FString(TEXT("BankLookup")); }
     static inline FString AssetLookupName() { return FString(TEXT("AssetLookup")); }
 
 private:
+    struct FAssetLocation
+    {
+        FString PackageName;
+        FString AssetName;
+    };
+
     FString GetBankPathByGuid(const FGuid& Guid) const;
-    FString GetLocalizedBankPath(const UDataTable* BankTable) const;
+
+    /** Rebuild the lookup maps from the loaded lookup tables. */
+    void BuildIndex();
+
+    /** Resolve the bank path for the active locale of every bank. */
+    void BuildActiveBankPaths();
+
+#if WITH_EDITOR
+    void OnPackageMarkedDirty(UPackage *Package, bool bWasDirty);
+#endif
+
+    /** Find an asset that is already resident, caching it if its package was loaded by someone else. */
+    UFMODAsset *FindResidentAsset(const FString &StudioPath, const FAssetLocation &Location);
+
+    void OnAssetPackageLoaded(const FName &PackageName, UPackage *Package, EAsyncLoadingResult::Type Result, FString StudioPath, uint32 Generation);
 
     FString ActiveLocale;
     UFMODBankLookup *BankLookup;
     UDataTable *AssetLookup;
+
+    // Bank paths keyed by bank guid then locale code, and the paths resolved for the active locale.
+    TMap<FGuid, TMap<FString, FString>> LocalizedBankPaths;
+    TMap<FGuid, FString> ActiveBankPaths;
+
+    // Asset packages keyed by studio path.
+    TMap<FString, FAssetLocation> AssetLocations;
+
+    // Assets that have already been resolved, kept referenced so later lookups are free.
+    TMap<FString, UFMODAsset *> ResidentAssets;
+
+    // Callbacks waiting on an asynchronous package load, keyed by studio path.
+    TMap<FString, TArray<FOnFMODAssetFound>> PendingAssetLoads;
+
+    // The lookups the maps were built from, and whether they have been modified since.
+    UFMODBankLookup *IndexedBankLookup;
+    UDataTable *IndexedAssetLookup;
+    bool bIndexStale;
+
+    // Bumped every time the index is rebuilt. Pending package loads only hold a weak reference to it, so their
+    // completions are dropped once the table is destroyed and requested again once the index has been rebuilt.
+    TSharedRef<uint32> IndexGeneration;
+
+#if WITH_EDITOR
+    FDelegateHandle PackageMarkedDirtyHandle;
+#endif
 };
@@ -5,6 +5,9 @@
 #include "FMODUtils.h"
 #include "FMODEvent.h"
 #include "FMODListener.h"
+#include "FMODAudioComponentPool.h"
+#include "FMODOcclusion.h"
+#include "FMODInteriorVolumes.h"
 #include "FMODSettings.h"
 #include "fmod_studio.hpp"
 #include "Misc/App.h"
@@ -20,6 +23,7 @@ UFMODAudioComponent::UFMODAudioComponent(const FObjectInitializer &ObjectInitial
     : Super(ObjectInitializer)
 {
     bAutoDestroy = false;
+    bPooled = false;
     bAutoActivate = true;
     bEnableTimelineCallbacks = false; // Default OFF for efficiency
     bStopWhenOwnerDestroyed = true;
@@ -37,11 +41,15 @@ UFMODAudioComponent::UFMODAudioComponent(const FObjectInitializer &ObjectInitial
 
     StudioInstance = nullptr;
     ProgrammerSound = nullptr;
+    ParameterIDsDescription = nullptr;
 
     LastLPF = MAX_FILTER_FREQUENCY;
     LastVolume = 1.0f;
     Module = nullptr;
     wasOccluded = false;
+    NextOcclusionUpdateTime = 0.0;
+    NextSpatialUpdateTime = 0.0;
+    bSpatialUpdatePending = false;
 
     for (int i = 0; i < EFMODEventProperty::Count; ++i)
     {
@@ -133,12 +141,63 @@ void UFMODAudioComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransfor
 
         StudioInstance->set3DAttributes(&attr);
 
-        UpdateInteriorVolumes();
-        UpdateAttenuation();
-        ApplyVolumeLPF();
+        UpdateSpatialState();
     }
 }
 
+void UFMODAudioComponent::UpdateSpatialState()
+{
+    const double CurrentTime = FApp::GetCurrentTime();
+    if (CurrentTime < NextSpatialUpdateTime)
+    {
+        // Picked up by tick once the interval passes, even if nothing moves again
+        bSpatialUpdatePending = true;
+        return;
+    }
+
+    UpdateInteriorVolumes();
+    UpdateAttenuation();
+    ApplyVolumeLPF();
+
+    bSpatialUpdatePending = false;
+    NextSpatialUpdateTime = CurrentTime + GetSpatialUpdateInterval();
+}
+
+float UFMODAudioComponent::GetSpatialUpdateInterval()
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+    if (Settings.SpatialUpdateInterval <= 0.0f || !StudioInstance)
+    {
+        return 0.0f;
+    }
+
+    bool bVirtual = false;
+    if (StudioInstance->isVirtual(&bVirtual) == FMOD_OK && bVirtual)
+    {
+        return Settings.SpatialUpdateInterval;
+    }
+
+    const FVector Location = GetComponentTransform().GetLocation();
+    const FFMODListener &Listener = GetStudioModule().GetNearestListener(Location);
+    const float Distance = FVector::Dist(Location, Listener.Transform.GetLocation());
+
+    // Can't be heard beyond the event's maximum distance
+    float MinDistance = 0.0f;
+    float MaxDistance = 0.0f;
+    if (StudioInstance->getMinMaxDistance(&MinDistance, &MaxDistance) == FMOD_OK && MaxDistance > 0.0f &&
+        Distance > FMODUtils::DistanceToUEScale(MaxDistance))
+    {
+        return Settings.SpatialUpdateInterval;
+    }
+
+    float DistanceFactor = 1.0f;
+    if (Settings.SpatialUpdateDistance > 0.0f)
+    {
+        DistanceFactor = FMath::Min(Distance / Settings.SpatialUpdateDistance, 1.0f);
+    }
+    return Settings.SpatialUpdateInterval * DistanceFactor;
+}
+
 // Taken mostly from ActiveSound.cpp
 void UFMODAudioComponent::UpdateInteriorVolumes()
 {
@@ -155,7 +214,7 @@ void UFMODAudioComponent::UpdateInteriorVolumes()
     FInteriorSettings *Ambient =
         (FInteriorSettings *)alloca(sizeof(FInteriorSettings)); // FinteriorSetting::FInteriorSettings() isn't exposed (possible UE4 bug???)
     const FVector &Location = GetOwner()->GetTransform().GetTranslation();
-    AAudioVolume *AudioVolume = GetWorld()->GetAudioSettings(Location, NULL, Ambient);
+    AAudioVolume *AudioVolume = FFMODInteriorVolumeManager::Get().FindComponentVolume(this, Location, Ambient);
 
     const FFMODListener &Listener = GetStudioModule().GetNearestListener(Location);
     if (InteriorLastUpdateTime < Listener.InteriorStartTime)
@@ -241,18 +300,27 @@ void UFMODAudioComponent::UpdateAttenuation()
     // Use occlusion part of settings
     if (OcclusionDetails.bEnableOcclusion && bApplyOcclusionParameter)
     {
-        static FName NAME_SoundOcclusion = FName(TEXT("SoundOcclusion"));
-        FCollisionQueryParams Params(NAME_SoundOcclusion, OcclusionDetails.bUseComplexCollisionForOcclusion, GetOwner());
+        const double CurrentTime = FApp::GetCurrentTime();
+        if (CurrentTime >= NextOcclusionUpdateTime)
+        {
+            static FName NAME_SoundOcclusion = FName(TEXT("SoundOcclusion"));
+            FCollisionQueryParams Params(NAME_SoundOcclusion, OcclusionDetails.bUseComplexCollisionForOcclusion, GetOwner());
 
-        const FVector &Location = GetOwner()->GetTransform().GetTranslation();
-        const FFMODListener &Listener = GetStudioModule().GetNearestListener(Location);
+            const FVector &Location = GetOwner()->GetTransform().GetTranslation();
+            const FFMODListener &Listener = GetStudioModule().GetNearestListener(Location);
 
-        bool bIsOccluded = GWorld->LineTraceTestByChannel(Location, Listener.Transform.GetLocation(), OcclusionDetails.OcclusionTraceChannel, Params);
+            // The trace result arrives on a later frame through OnOcclusionTraceCompleted
+            FFMODOcclusionManager::Get().RequestTrace(
+                this, Location, Listener.Transform.GetLocation(), OcclusionDetails.OcclusionTraceChannel, Params);
 
-        if (bIsOccluded != wasOccluded)
-        {
-            StudioInstance->setParameterByID(OcclusionID, bIsOccluded ? 1.0f : 0.0f);
-            wasOccluded = bIsOccluded;
+            // Distant emitters refresh their occlusion less often
+            const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+            float DistanceFactor = 1.0f;
+            if (Settings.OcclusionUpdateDistance > 0.0f)
+            {
+                DistanceFactor = FMath::Min(FVector::Dist(Location, Listener.Transform.GetLocation()) / Settings.OcclusionUpdateDistance, 1.0f);
+            }
+            NextOcclusionUpdateTime = CurrentTime + Settings.OcclusionUpdateInterval * DistanceFactor;
         }
     }
     else
@@ -261,6 +329,20 @@ void UFMODAudioComponent::UpdateAttenuation()
     }
 }
 
+void UFMODAudioComponent::OnOcclusionTraceCompleted(bool bIsOccluded)
+{
+    if (!StudioInstance || !OcclusionDetails.bEnableOcclusion || !bApplyOcclusionParameter)
+    {
+        return;
+    }
+
+    if (bIsOccluded != wasOccluded)
+    {
+        StudioInstance->setParameterByID(OcclusionID, bIsOccluded ? 1.0f : 0.0f);
+        wasOccluded = bIsOccluded;
+    }
+}
+
 void UFMODAudioComponent::ApplyVolumeLPF()
 {
     if (bApplyAmbientVolumes)
@@ -310,6 +392,14 @@ void UFMODAudioComponent::CacheDefaultParameterValues()
 
 void UFMODAudioComponent::OnUnregister()
 {
+    if (FFMODOcclusionManager *OcclusionManager = FFMODOcclusionManager::GetIfCreated())
+    {
+        OcclusionManager->CancelTrace(this);
+    }
+    if (FFMODInteriorVolumeManager *InteriorVolumeManager = FFMODInteriorVolumeManager::GetIfCreated())
+    {
+        InteriorVolumeManager->RemoveComponent(this);
+    }
     if (bStopWhenOwnerDestroyed)
     {
         Stop();
@@ -359,11 +449,9 @@ void UFMODAudioComponent::TickComponent(float DeltaTime, enum ELevelTick TickTyp
 
         if (StudioInstance)
         {
-            if (GetStudioModule().HasListenerMoved())
+            if (GetStudioModule().HasListenerMoved() || bSpatialUpdatePending)
             {
-                UpdateInteriorVolumes();
-                UpdateAttenuation();
-                ApplyVolumeLPF();
+                UpdateSpatialState();
             }
 
             if (bEnableTimelineCallbacks)
@@ -625,50 +713,43 @@ void UFMODAudioComponent::PlayInternal(EFMODSystemContext::Type Context, bool bR
                 return;
         }
 
+        CacheParameterIDs(EventDesc);
+
+        // A reused or pooled component may still hold the IDs of the previous event
+        bApplyOcclusionParameter = false;
+        bApplyAmbientVolumes = false;
+
         const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
-        FMOD_STUDIO_PARAMETER_DESCRIPTION paramDesc = {};
-        FString param = Settings.OcclusionParameter;
-        if (!param.IsEmpty())
+        if (!Settings.OcclusionParameter.IsEmpty())
         {
-            if (EventDesc->getParameterDescriptionByName(TCHAR_TO_UTF8(*Settings.OcclusionParameter), &paramDesc) == FMOD_OK)
+            if (const FMOD_STUDIO_PARAMETER_ID *ID = FindParameterID(FName(*Settings.OcclusionParameter)))
             {
-                OcclusionID = paramDesc.id;
+                OcclusionID = *ID;
                 bApplyOcclusionParameter = true;
             }
         }
 
-        paramDesc = {};
-        param = Settings.AmbientVolumeParameter;
-        if (!param.IsEmpty())
+        if (!Settings.AmbientVolumeParameter.IsEmpty())
         {
-            if (EventDesc->getParameterDescriptionByName(TCHAR_TO_UTF8(*param), &paramDesc) == FMOD_OK)
+            if (const FMOD_STUDIO_PARAMETER_ID *ID = FindParameterID(FName(*Settings.AmbientVolumeParameter)))
             {
-                AmbientVolumeID = paramDesc.id;
+                AmbientVolumeID = *ID;
                 bApplyAmbientVolumes = true;
             }
         }
 
-        paramDesc = {};
-        param = Settings.AmbientLPFParameter;
-        if (!param.IsEmpty())
+        if (!Settings.AmbientLPFParameter.IsEmpty())
         {
-            if (EventDesc->getParameterDescriptionByName(TCHAR_TO_UTF8(*Settings.AmbientLPFParameter), &paramDesc) == FMOD_OK)
+            if (const FMOD_STUDIO_PARAMETER_ID *ID = FindParameterID(FName(*Settings.AmbientLPFParameter)))
             {
-                AmbientLPFID = paramDesc.id;
+                AmbientLPFID = *ID;
                 bApplyAmbientVolumes = true;
             }
         }
 
         OnUpdateTransform(EUpdateTransformFlags::SkipPhysicsUpdate);
         // Set initial parameters
-        for (auto Kvp : ParameterCache)
-        {
-            FMOD_RESULT Result = StudioInstance->setParameterByName(TCHAR_TO_UTF8(*Kvp.Key.ToString()), Kvp.Value);
-            if (Result != FMOD_OK)
-            {
-                UE_LOG(LogFMOD, Warning, TEXT("Failed to set initial parameter %s"), *Kvp.Key.ToString());
-            }
-        }
+        ApplyParameters(ParameterCache);
         for (int i = 0; i < EFMODEventProperty::Count; ++i)
         {
             if (StoredProperties[i] != -1.0f)
@@ -707,6 +788,9 @@ void UFMODAudioComponent::Stop()
     }
 
     wasOccluded = false;
+    NextOcclusionUpdateTime = 0.0;
+    NextSpatialUpdateTime = 0.0;
+    bSpatialUpdatePending = false;
 }
 
 void UFMODAudioComponent::Release()
@@ -718,9 +802,71 @@ void UFMODAudioComponent::ReleaseEventCache()
 {
     ParameterCache.Empty();
     bDefaultParameterValuesCached = false;
+    ParameterIDs.Empty();
+    ParameterIDsDescription = nullptr;
     ReleaseEventInstance();
 }
 
+void UFMODAudioComponent::CacheParameterIDs(FMOD::Studio::EventDescription *EventDesc)
+{
+    if (EventDesc == ParameterIDsDescription)
+    {
+        return;
+    }
+
+    ParameterIDs.Reset();
+    ParameterIDsDescription = EventDesc;
+
+    int ParameterCount = 0;
+    verifyfmod(EventDesc->getParameterDescriptionCount(&ParameterCount));
+    for (int i = 0; i < ParameterCount; ++i)
+    {
+        // Only parameters the game can set on this instance, anything else would fail a batched set
+        FMOD_STUDIO_PARAMETER_DESCRIPTION ParameterDescription = {};
+        if (EventDesc->getParameterDescriptionByIndex(i, &ParameterDescription) == FMOD_OK &&
+            !(ParameterDescription.flags & (FMOD_STUDIO_PARAMETER_READONLY | FMOD_STUDIO_PARAMETER_AUTOMATIC | FMOD_STUDIO_PARAMETER_GLOBAL)))
+        {
+            ParameterIDs.Add(FName(UTF8_TO_TCHAR(ParameterDescription.name)), ParameterDescription.id);
+        }
+    }
+}
+
+void UFMODAudioComponent::ApplyParameters(const TMap<FName, float> &Parameters)
+{
+    TArray<FMOD_STUDIO_PARAMETER_ID, TInlineAllocator<16>> IDs;
+    TArray<float, TInlineAllocator<16>> Values;
+    TArray<FName, TInlineAllocator<16>> Names;
+
+    for (const TPair<FName, float> &Kvp : Parameters)
+    {
+        if (const FMOD_STUDIO_PARAMETER_ID *ID = FindParameterID(Kvp.Key))
+        {
+            IDs.Add(*ID);
+            Values.Add(Kvp.Value);
+            Names.Add(Kvp.Key);
+        }
+        else if (StudioInstance->setParameterByName(TCHAR_TO_UTF8(*Kvp.Key.ToString()), Kvp.Value) != FMOD_OK)
+        {
+            UE_LOG(LogFMOD, Warning, TEXT("Failed to set parameter %s"), *Kvp.Key.ToString());
+        }
+    }
+
+    if (IDs.Num() > 0)
+    {
+        if (StudioInstance->setParametersByIDs(IDs.GetData(), Values.GetData(), IDs.Num()) != FMOD_OK)
+        {
+            // One bad value fails the whole batch, set them one at a time so the rest still apply
+            for (int32 i = 0; i < IDs.Num(); ++i)
+            {
+                if (StudioInstance->setParameterByID(IDs[i], Values[i]) != FMOD_OK)
+                {
+                    UE_LOG(LogFMOD, Warning, TEXT("Failed to set parameter %s"), *Names[i].ToString());
+                }
+            }
+        }
+    }
+}
+
 void UFMODAudioComponent::ReleaseEventInstance()
 {
     if (StudioInstance)
@@ -756,6 +902,11 @@ void UFMODAudioComponent::OnPlaybackCompleted()
     SetActive(false);
     SetComponentTickEnabled(false);
 
+    if (FFMODInteriorVolumeManager *InteriorVolumeManager = FFMODInteriorVolumeManager::GetIfCreated())
+    {
+        InteriorVolumeManager->RemoveComponent(this);
+    }
+
     if (StudioInstance)
     {
         UE_LOG(LogFMOD, Verbose, TEXT("UFMODAudioComponent %p PlaybackCompleted"), this);
@@ -766,12 +917,39 @@ void UFMODAudioComponent::OnPlaybackCompleted()
     }
     
     // Auto destruction is handled via marking object for deletion.
-    if (bAutoDestroy)
+    if (bAutoDestroy && !(bPooled && FFMODAudioComponentPool::Get().Release(this)))
     {
         DestroyComponent();
     }
 }
 
+void UFMODAudioComponent::ResetForPool()
+{
+    ReleaseEventCache();
+    ProgrammerSoundName.Empty();
+    ProgrammerSound = nullptr;
+    bEnableTimelineCallbacks = false;
+    for (int i = 0; i < EFMODEventProperty::Count; ++i)
+    {
+        StoredProperties[i] = -1.0f;
+    }
+
+    OnEventStopped.Clear();
+    OnTimelineMarker.Clear();
+    OnTimelineBeat.Clear();
+
+    AttenuationDetails = FFMODAttenuationDetails();
+    OcclusionDetails = FFMODOcclusionDetails();
+    wasOccluded = false;
+    NextOcclusionUpdateTime = 0.0;
+    NextSpatialUpdateTime = 0.0;
+    bSpatialUpdatePending = false;
+    LastVolume = 1.0f;
+    LastLPF = MAX_FILTER_FREQUENCY;
+
+    DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+}
+
 bool UFMODAudioComponent::IsPlaying(void)
 {
     return IsActive();
@@ -817,7 +995,8 @@ void UFMODAudioComponent::SetParameter(FName Name, float Value)
 {
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->setParameterByName(TCHAR_TO_UTF8(*Name.ToString()), Value);
+        const FMOD_STUDIO_PARAMETER_ID *ID = FindParameterID(Name);
+        FMOD_RESULT Result = ID ? StudioInstance->setParameterByID(*ID, Value) : StudioInstance->setParameterByName(TCHAR_TO_UTF8(*Name.ToString()), Value);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to set parameter %s"), *Name.ToString());
@@ -826,6 +1005,18 @@ void UFMODAudioComponent::SetParameter(FName Name, float Value)
     ParameterCache.FindOrAdd(Name) = Value;
 }
 
+void UFMODAudioComponent::SetParameters(const TMap<FName, float> &Parameters)
+{
+    if (StudioInstance)
+    {
+        ApplyParameters(Parameters);
+    }
+    for (const TPair<FName, float> &Kvp : Parameters)
+    {
+        ParameterCache.FindOrAdd(Kvp.Key) = Kvp.Value;
+    }
+}
+
 void UFMODAudioComponent::SetProperty(EFMODEventProperty::Type Property, float Value)
 {
     verify(Property < EFMODEventProperty::Count);
@@ -897,7 +1088,8 @@ float UFMODAudioComponent::GetParameter(FName Name)
     float Value = CachedValue ? *CachedValue : 0.0;
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &Value);
+        const FMOD_STUDIO_PARAMETER_ID *ID = FindParameterID(Name);
+        FMOD_RESULT Result = ID ? StudioInstance->getParameterByID(*ID, &Value) : StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &Value);
         if (Result != FMOD_OK)
         {
             UE_LOG(LogFMOD, Warning, TEXT("Failed to get parameter %s"), *Name.ToString());
@@ -916,7 +1108,9 @@ void UFMODAudioComponent::GetParameterValue(FName Name, float &UserValue, float
     float *CachedValue = ParameterCache.Find(Name);
     if (StudioInstance)
     {
-        FMOD_RESULT Result = StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &UserValue, &FinalValue);
+        const FMOD_STUDIO_PARAMETER_ID *ID = FindParameterID(Name);
+        FMOD_RESULT Result = ID ? StudioInstance->getParameterByID(*ID, &UserValue, &FinalValue) :
+                                  StudioInstance->getParameterByName(TCHAR_TO_UTF8(*Name.ToString()), &UserValue, &FinalValue);
         if (Result != FMOD_OK)
         {
             UserValue = FinalValue = 0;
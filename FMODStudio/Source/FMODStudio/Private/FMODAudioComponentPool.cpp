@@ -0,0 +1,110 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2021.
+
+#include "FMODAudioComponentPool.h"
+#include "FMODAudioComponent.h"
+#include "FMODSettings.h"
+#include "GameFramework/Actor.h"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODAudioComponentPool *FFMODAudioComponentPool::Instance = nullptr;
+
+FFMODAudioComponentPool &FFMODAudioComponentPool::Get()
+{
+    if (!Instance)
+    {
+        Instance = new FFMODAudioComponentPool();
+    }
+    return *Instance;
+}
+
+void FFMODAudioComponentPool::Shutdown()
+{
+    delete Instance;
+    Instance = nullptr;
+}
+
+FFMODAudioComponentPool::FFMODAudioComponentPool()
+{
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FFMODAudioComponentPool::OnWorldCleanup);
+}
+
+FFMODAudioComponentPool::~FFMODAudioComponentPool()
+{
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+}
+
+UFMODAudioComponent *FFMODAudioComponentPool::Acquire(AActor *Owner)
+{
+    TArray<TWeakObjectPtr<UFMODAudioComponent>> *Idle = IdleComponents.Find(Owner->GetWorld());
+    if (Idle)
+    {
+        // Most recently released first, they are the least likely to have been evicted soon
+        for (int32 i = Idle->Num() - 1; i >= 0; --i)
+        {
+            UFMODAudioComponent *Component = (*Idle)[i].Get();
+            if (!IsValid(Component) || !Component->IsRegistered())
+            {
+                // Destroyed along with its owner
+                Idle->RemoveAt(i);
+            }
+            else if (Component->GetOwner() == Owner)
+            {
+                // Only the owning actor can reuse a component, see the class comment
+                Idle->RemoveAt(i);
+                ++Stats.Hits;
+                return Component;
+            }
+        }
+    }
+
+    ++Stats.Misses;
+    return nullptr;
+}
+
+bool FFMODAudioComponentPool::Release(UFMODAudioComponent *Component)
+{
+    const int32 PoolSize = GetDefault<UFMODSettings>()->AudioComponentPoolSize;
+    UWorld *World = Component->GetWorld();
+    if (PoolSize <= 0 || !World || !Component->GetOwner() || Component->GetOwner()->IsPendingKill())
+    {
+        return false;
+    }
+
+    Component->ResetForPool();
+
+    TArray<TWeakObjectPtr<UFMODAudioComponent>> &Idle = IdleComponents.FindOrAdd(World);
+    Idle.Add(Component);
+
+    while (Idle.Num() > PoolSize)
+    {
+        UFMODAudioComponent *Oldest = Idle[0].Get();
+        Idle.RemoveAt(0);
+        if (IsValid(Oldest))
+        {
+            Oldest->DestroyComponent();
+            ++Stats.Evictions;
+        }
+    }
+
+    return true;
+}
+
+int32 FFMODAudioComponentPool::GetIdleCount(UWorld *World) const
+{
+    const TArray<TWeakObjectPtr<UFMODAudioComponent>> *Idle = IdleComponents.Find(World);
+    return Idle ? Idle->Num() : 0;
+}
+
+void FFMODAudioComponentPool::OnWorldCleanup(UWorld *World, bool bSessionEnded, bool bCleanupResources)
+{
+    IdleComponents.Remove(World);
+
+    // Also drop entries for worlds that have already gone away
+    for (auto It = IdleComponents.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
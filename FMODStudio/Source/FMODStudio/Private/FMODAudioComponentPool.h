@@ -0,0 +1,70 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2021.
+
+#pragma once
+
+#include "Engine/World.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class UFMODAudioComponent;
+
+/** Counters describing how well the audio component pool is being used. */
+struct FFMODAudioComponentPoolStats
+{
+    /** Number of components handed out from the pool. */
+    int32 Hits;
+
+    /** Number of times no idle component was available and a new one had to be created. */
+    int32 Misses;
+
+    /** Number of idle components destroyed to keep the pool within its size. */
+    int32 Evictions;
+
+    FFMODAudioComponentPoolStats()
+        : Hits(0)
+        , Misses(0)
+        , Evictions(0)
+    {
+    }
+};
+
+/**
+ * Recycles auto-destroying audio components created by UFMODBlueprintStatics::PlayEventAttached.
+ * Finished components stay registered and are kept per world, oldest released first, until another event is
+ * played on the same owning actor. When a world holds more idle components than the configured pool size the
+ * oldest one is destroyed.
+ * Components are never moved to another actor, since that would mean renaming them into the new owner. An idle
+ * component on one actor can't serve a request from another, so the hit rate depends on actors replaying events.
+ */
+class FFMODAudioComponentPool
+{
+public:
+    static FFMODAudioComponentPool &Get();
+    static FFMODAudioComponentPool *GetIfCreated() { return Instance; }
+    static void Shutdown();
+
+    ~FFMODAudioComponentPool();
+
+    /** Take an idle component owned by the given actor, or return null if there is none. */
+    UFMODAudioComponent *Acquire(AActor *Owner);
+
+    /** Return a finished component to the pool. Returns false if the pool can't take it and it should be destroyed instead. */
+    bool Release(UFMODAudioComponent *Component);
+
+    /** Number of idle components currently held for a world. */
+    int32 GetIdleCount(UWorld *World) const;
+
+    const FFMODAudioComponentPoolStats &GetStats() const { return Stats; }
+    void ResetStats() { Stats = FFMODAudioComponentPoolStats(); }
+
+private:
+    FFMODAudioComponentPool();
+
+    void OnWorldCleanup(UWorld *World, bool bSessionEnded, bool bCleanupResources);
+
+    TMap<TWeakObjectPtr<UWorld>, TArray<TWeakObjectPtr<UFMODAudioComponent>>> IdleComponents;
+    FFMODAudioComponentPoolStats Stats;
+    FDelegateHandle WorldCleanupHandle;
+
+    static FFMODAudioComponentPool *Instance;
+};
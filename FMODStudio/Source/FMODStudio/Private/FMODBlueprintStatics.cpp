@@ -2,6 +2,8 @@
 
 #include "FMODBlueprintStatics.h"
 #include "FMODAudioComponent.h"
+#include "FMODAudioComponentPool.h"
+#include "FMODEventInstancePool.h"
 #include "FMODSettings.h"
 #include "FMODStudioModule.h"
 #include "FMODUtils.h"
@@ -38,8 +40,13 @@ FFMODEventInstance UFMODBlueprintStatics::PlayEventAtLocation(
         FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(Event);
         if (EventDesc != nullptr)
         {
-            FMOD::Studio::EventInstance *EventInst = nullptr;
-            EventDesc->createInstance(&EventInst);
+            // Only auto played one-shots are pooled, other instances belong to the caller
+            FMOD::Studio::EventInstance *EventInst = bAutoPlay ? FFMODEventInstancePool::Get().Acquire(EventDesc) : nullptr;
+            const bool bPooled = EventInst != nullptr;
+            if (!bPooled)
+            {
+                EventDesc->createInstance(&EventInst);
+            }
             if (EventInst != nullptr)
             {
                 FMOD_3D_ATTRIBUTES EventAttr = { { 0 } };
@@ -49,9 +56,13 @@ FFMODEventInstance UFMODBlueprintStatics::PlayEventAtLocation(
                 if (bAutoPlay)
                 {
                     EventInst->start();
-                    EventInst->release();
+                    if (!bPooled)
+                    {
+                        EventInst->release();
+                    }
                 }
-                Instance.Instance = EventInst;
+                // The pool keeps its instances, a handle to one would later refer to an unrelated one-shot
+                Instance.Instance = bPooled ? nullptr : EventInst;
             }
         }
     }
@@ -79,26 +90,37 @@ class UFMODAudioComponent *UFMODBlueprintStatics::PlayEventAttached(class UFMODE
         return nullptr;
     }
 
-    UFMODAudioComponent *AudioComponent;
-    if (Actor)
-    {
-        // Use actor as outer if we have one.
-        AudioComponent = NewObject<UFMODAudioComponent>(Actor);
-    }
-    else
+    // Fire and forget components on an actor can be recycled once they finish.
+    const bool bUsePool = Actor && bAutoDestroy && GetDefault<UFMODSettings>()->AudioComponentPoolSize > 0;
+
+    UFMODAudioComponent *AudioComponent = bUsePool ? FFMODAudioComponentPool::Get().Acquire(Actor) : nullptr;
+    const bool bReused = AudioComponent != nullptr;
+    if (!bReused)
     {
-        // Let engine pick the outer (transient package).
-        AudioComponent = NewObject<UFMODAudioComponent>();
+        if (Actor)
+        {
+            // Use actor as outer if we have one.
+            AudioComponent = NewObject<UFMODAudioComponent>(Actor);
+        }
+        else
+        {
+            // Let engine pick the outer (transient package).
+            AudioComponent = NewObject<UFMODAudioComponent>();
+        }
     }
     check(AudioComponent);
     AudioComponent->Event = Event;
     AudioComponent->bAutoActivate = false;
     AudioComponent->bAutoDestroy = bAutoDestroy;
+    AudioComponent->bPooled = bUsePool;
     AudioComponent->bStopWhenOwnerDestroyed = bStopWhenAttachedToDestroyed;
 #if WITH_EDITORONLY_DATA
     AudioComponent->bVisualizeComponent = false;
 #endif
-    AudioComponent->RegisterComponentWithWorld(AttachToComponent->GetWorld());
+    if (!bReused)
+    {
+        AudioComponent->RegisterComponentWithWorld(AttachToComponent->GetWorld());
+    }
 
     AudioComponent->AttachToComponent(AttachToComponent, FAttachmentTransformRules::KeepRelativeTransform, AttachPointName);
     if (LocationType == EAttachLocation::KeepWorldPosition)
@@ -127,6 +149,18 @@ UFMODEvent *UFMODBlueprintStatics::FindEventByName(const FString &Name)
     return IFMODStudioModule::Get().FindEventByName(Name);
 }
 
+void UFMODBlueprintStatics::FindAssetByNameAsync(const FString &Name, FOnFMODAssetFoundDynamic OnFound)
+{
+    IFMODStudioModule::Get().FindAssetByNameAsync(Name, FOnFMODAssetFound::CreateLambda([OnFound](UFMODAsset *Asset) {
+        OnFound.ExecuteIfBound(Asset);
+    }));
+}
+
+void UFMODBlueprintStatics::PrefetchAssetsByName(const TArray<FString> &Names)
+{
+    IFMODStudioModule::Get().PrefetchAssetsByName(Names);
+}
+
 void UFMODBlueprintStatics::LoadBank(class UFMODBank *Bank, bool bBlocking, bool bLoadSampleData)
 {
     FMOD::Studio::System *StudioSystem = IFMODStudioModule::Get().GetStudioSystem(EFMODSystemContext::Runtime);
@@ -230,6 +264,18 @@ void UFMODBlueprintStatics::LoadEventSampleData(UObject *WorldContextObject, cla
     }
 }
 
+void UFMODBlueprintStatics::PrewarmEventInstances(class UFMODEvent *Event)
+{
+    if (IsValid(Event))
+    {
+        FMOD::Studio::EventDescription *EventDesc = IFMODStudioModule::Get().GetEventDescription(Event);
+        if (EventDesc != nullptr)
+        {
+            FFMODEventInstancePool::Get().Prewarm(EventDesc);
+        }
+    }
+}
+
 void UFMODBlueprintStatics::UnloadEventSampleData(UObject *WorldContextObject, class UFMODEvent *Event)
 {
     if (IsValid(Event))
@@ -0,0 +1,154 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2021.
+
+#include "FMODEventInstancePool.h"
+#include "FMODSettings.h"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODEventInstancePool *FFMODEventInstancePool::Instance = nullptr;
+
+FFMODEventInstancePool &FFMODEventInstancePool::Get()
+{
+    if (!Instance)
+    {
+        Instance = new FFMODEventInstancePool();
+    }
+    return *Instance;
+}
+
+void FFMODEventInstancePool::Shutdown()
+{
+    delete Instance;
+    Instance = nullptr;
+}
+
+FFMODEventInstancePool::~FFMODEventInstancePool()
+{
+    Reset();
+}
+
+FMOD::Studio::EventInstance *FFMODEventInstancePool::Acquire(FMOD::Studio::EventDescription *EventDesc)
+{
+    const int32 PoolSize = GetDefault<UFMODSettings>()->EventInstancePoolSize;
+    if (PoolSize <= 0)
+    {
+        return nullptr;
+    }
+
+    FEventPool &Pool = FindOrAddPool(EventDesc);
+
+    // Start from where the last search stopped, the instances just after it are the ones played longest ago
+    const int32 Num = Pool.Instances.Num();
+    for (int32 Offset = 0; Offset < Num; ++Offset)
+    {
+        const int32 Index = (Pool.NextIndex + Offset) % Num;
+        FMOD::Studio::EventInstance *EventInst = Pool.Instances[Index];
+
+        FMOD_STUDIO_PLAYBACK_STATE State = FMOD_STUDIO_PLAYBACK_STOPPED;
+        if (EventInst->getPlaybackState(&State) != FMOD_OK || State != FMOD_STUDIO_PLAYBACK_STOPPED)
+        {
+            continue;
+        }
+
+        Pool.NextIndex = (Index + 1) % Num;
+        if (Pool.ParameterIDs.Num() > 0)
+        {
+            EventInst->setParametersByIDs(Pool.ParameterIDs.GetData(), Pool.ParameterDefaults.GetData(), Pool.ParameterIDs.Num(), true);
+        }
+        EventInst->setVolume(1.0f);
+        EventInst->setPitch(1.0f);
+        EventInst->setPaused(false);
+        EventInst->setCallback(nullptr);
+        EventInst->setUserData(nullptr);
+        for (int Property = 0; Property < FMOD_STUDIO_EVENT_PROPERTY_MAX; ++Property)
+        {
+            // -1 restores the value set in Studio
+            EventInst->setProperty((FMOD_STUDIO_EVENT_PROPERTY)Property, -1.0f);
+        }
+        for (int Reverb = 0; Reverb < FMOD_REVERB_MAXINSTANCES; ++Reverb)
+        {
+            EventInst->setReverbLevel(Reverb, 1.0f);
+        }
+
+        ++Stats.Hits;
+        return EventInst;
+    }
+
+    if (Num >= PoolSize)
+    {
+        ++Stats.Overflows;
+        return nullptr;
+    }
+
+    ++Stats.Misses;
+    return CreateInstance(EventDesc, Pool);
+}
+
+void FFMODEventInstancePool::Prewarm(FMOD::Studio::EventDescription *EventDesc)
+{
+    const int32 PoolSize = GetDefault<UFMODSettings>()->EventInstancePoolSize;
+    if (PoolSize <= 0 || EventDesc == nullptr)
+    {
+        return;
+    }
+
+    FEventPool &Pool = FindOrAddPool(EventDesc);
+    while (Pool.Instances.Num() < PoolSize && CreateInstance(EventDesc, Pool))
+    {
+    }
+}
+
+void FFMODEventInstancePool::Reset()
+{
+    // Instances that are still playing are destroyed by FMOD once they stop
+    for (auto &Entry : Pools)
+    {
+        for (FMOD::Studio::EventInstance *EventInst : Entry.Value.Instances)
+        {
+            EventInst->release();
+        }
+    }
+    Pools.Reset();
+}
+
+FFMODEventInstancePool::FEventPool &FFMODEventInstancePool::FindOrAddPool(FMOD::Studio::EventDescription *EventDesc)
+{
+    if (FEventPool *Existing = Pools.Find(EventDesc))
+    {
+        // Instances released elsewhere or unloaded along with their bank
+        Existing->Instances.RemoveAll([](FMOD::Studio::EventInstance *EventInst) { return !EventInst->isValid(); });
+        if (Existing->NextIndex >= Existing->Instances.Num())
+        {
+            Existing->NextIndex = 0;
+        }
+        return *Existing;
+    }
+
+    FEventPool &Pool = Pools.Add(EventDesc);
+
+    // Remember the defaults of the parameters a caller can set, so they can be restored when an instance is reused
+    int ParameterCount = 0;
+    EventDesc->getParameterDescriptionCount(&ParameterCount);
+    for (int i = 0; i < ParameterCount; ++i)
+    {
+        FMOD_STUDIO_PARAMETER_DESCRIPTION ParameterDesc = {};
+        if (EventDesc->getParameterDescriptionByIndex(i, &ParameterDesc) == FMOD_OK &&
+            !(ParameterDesc.flags & (FMOD_STUDIO_PARAMETER_READONLY | FMOD_STUDIO_PARAMETER_AUTOMATIC | FMOD_STUDIO_PARAMETER_GLOBAL)))
+        {
+            Pool.ParameterIDs.Add(ParameterDesc.id);
+            Pool.ParameterDefaults.Add(ParameterDesc.defaultvalue);
+        }
+    }
+
+    return Pool;
+}
+
+FMOD::Studio::EventInstance *FFMODEventInstancePool::CreateInstance(FMOD::Studio::EventDescription *EventDesc, FEventPool &Pool)
+{
+    FMOD::Studio::EventInstance *EventInst = nullptr;
+    EventDesc->createInstance(&EventInst);
+    if (EventInst != nullptr)
+    {
+        Pool.Instances.Add(EventInst);
+    }
+    return EventInst;
+}
@@ -0,0 +1,77 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2021.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "fmod_studio.hpp"
+
+/** Counters describing how well the event instance pool is being used. */
+struct FFMODEventInstancePoolStats
+{
+    /** Number of one-shots played on an instance taken from the pool. */
+    int32 Hits;
+
+    /** Number of times no stopped instance was available and a new pooled instance had to be created. */
+    int32 Misses;
+
+    /** Number of times an event's pool was full and an unpooled instance was created and released instead. */
+    int32 Overflows;
+
+    FFMODEventInstancePoolStats()
+        : Hits(0)
+        , Misses(0)
+        , Overflows(0)
+    {
+    }
+};
+
+/**
+ * Keeps event instances created by UFMODBlueprintStatics::PlayEvent2D and PlayEventAtLocation alive instead of
+ * releasing them, so one-shots of the same event can restart an instance that has stopped rather than creating
+ * a new one. Each event description holds up to the configured pool size; once every instance is playing,
+ * further one-shots fall back to create, start and release.
+ * Pooled instances are never handed to callers, since a stored handle would later refer to an unrelated one-shot.
+ */
+class FFMODEventInstancePool
+{
+public:
+    static FFMODEventInstancePool &Get();
+    static FFMODEventInstancePool *GetIfCreated() { return Instance; }
+    static void Shutdown();
+
+    /**
+    * Get a stopped instance of the event, or create one if the event's pool has room. Parameters, properties, volume,
+    * pitch, reverb levels, pause state, callback and user data of a reused instance are restored to their defaults.
+    * Returns null if the pool is full or disabled, in which case the caller should create and release its own instance.
+    */
+    FMOD::Studio::EventInstance *Acquire(FMOD::Studio::EventDescription *EventDesc);
+
+    /** Create stopped instances of the event until its pool is full. */
+    void Prewarm(FMOD::Studio::EventDescription *EventDesc);
+
+    /** Release every pooled instance. Called when banks are reloaded or the runtime system is destroyed. */
+    void Reset();
+
+    const FFMODEventInstancePoolStats &GetStats() const { return Stats; }
+    void ResetStats() { Stats = FFMODEventInstancePoolStats(); }
+
+private:
+    struct FEventPool
+    {
+        TArray<FMOD::Studio::EventInstance *> Instances;
+        TArray<FMOD_STUDIO_PARAMETER_ID> ParameterIDs;
+        TArray<float> ParameterDefaults;
+        int32 NextIndex = 0;
+    };
+
+    FFMODEventInstancePool() {}
+    ~FFMODEventInstancePool();
+
+    FEventPool &FindOrAddPool(FMOD::Studio::EventDescription *EventDesc);
+    FMOD::Studio::EventInstance *CreateInstance(FMOD::Studio::EventDescription *EventDesc, FEventPool &Pool);
+
+    TMap<FMOD::Studio::EventDescription *, FEventPool> Pools;
+    FFMODEventInstancePoolStats Stats;
+
+    static FFMODEventInstancePool *Instance;
+};
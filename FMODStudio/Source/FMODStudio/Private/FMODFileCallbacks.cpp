@@ -4,8 +4,8 @@
 #include "FMODUtils.h"
 #include "HAL/FileManager.h"
 #include "GenericPlatform/GenericPlatformProcess.h"
-#include "HAL/Runnable.h"
-#include "HAL/RunnableThread.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/IQueuedWork.h"
 #include "Misc/ScopeLock.h"
 #include "FMODStudioPrivatePCH.h"
 
@@ -42,24 +42,12 @@ FMOD_RESULT F_CALLBACK FMODLogCallback(FMOD_DEBUG_FLAGS flags, const char *file,
     return FMOD_OK;
 }
 
-class FFMODFileSystem : public FRunnable
+class FFMODFileSystem
 {
 public:
     FFMODFileSystem()
-        : mHandleIn(nullptr)
-        , mName(nullptr)
-        , mFileSize(nullptr)
-        , mHandleOut(nullptr)
-        , mBuffer(nullptr)
-        , mSizeBytes(0)
-        , mBytesRead(nullptr)
-        , mSeekPosition(0)
-        , mCommand(COMMAND_MAX)
-        , mResult(FMOD_OK)
-        , mReferenceCount(0)
-        , mThread(nullptr)
-        , mCommandReadyEvent(nullptr)
-        , mCommandCompleteEvent(nullptr)
+        : mReferenceCount(0)
+        , mThreadPool(nullptr)
     {
     }
 
@@ -67,25 +55,28 @@ public:
     static FMOD_RESULT F_CALLBACK CloseCallback(void *handle, void * /*userdata*/);
     static FMOD_RESULT F_CALLBACK ReadCallback(void *handle, void *buffer, unsigned int sizebytes, unsigned int *bytesread, void * /*userdata*/);
     static FMOD_RESULT F_CALLBACK SeekCallback(void *handle, unsigned int pos, void * /*userdata*/);
+    static FMOD_RESULT F_CALLBACK AsyncReadCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/);
+    static FMOD_RESULT F_CALLBACK AsyncCancelCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/);
 
     static FMOD_RESULT OpenInternal(const char *name, unsigned int *filesize, void **handle);
     static FMOD_RESULT CloseInternal(void *handle);
     static FMOD_RESULT ReadInternal(void *handle, void *buffer, unsigned int sizebytes, unsigned int *bytesread);
     static FMOD_RESULT SeekInternal(void *handle, unsigned int pos);
+    static FMOD_RESULT AsyncReadInternal(FMOD_ASYNCREADINFO *info);
 
-    void IncrementReferenceCount()
+    void IncrementReferenceCount(int32 threadCount)
     {
         FScopeLock lock(&mCrit);
 
         ++mReferenceCount;
 
-        if (mReferenceCount == 1)
+        if (mReferenceCount == 1 && threadCount > 0)
         {
-            check(!mThread);
+            check(!mThreadPool);
 
-            mCommandReadyEvent = FGenericPlatformProcess::GetSynchEventFromPool();
-            mCommandCompleteEvent = FGenericPlatformProcess::GetSynchEventFromPool();
-            mThread = FRunnableThread::Create(this, TEXT("FMOD File Access Coordinator"));
+            mThreadPool = FQueuedThreadPool::Allocate();
+            // Use the default stack size, pak reads may decompress or decrypt on these threads
+            verify(mThreadPool->Create(threadCount, 0, TPri_Normal, TEXT("FMOD File Access")));
         }
     }
 
@@ -94,111 +85,110 @@ public:
         FScopeLock lock(&mCrit);
 
         check(mReferenceCount > 0);
-        check(mThread);
 
         --mReferenceCount;
 
-        if (mReferenceCount == 0)
+        if (mReferenceCount == 0 && mThreadPool)
         {
-            verifyfmod(RunCommand(COMMAND_STOP));
-            mThread->WaitForCompletion();
-
-            FGenericPlatformProcess::ReturnSynchEventToPool(mCommandReadyEvent);
-            mCommandReadyEvent = nullptr;
-            FGenericPlatformProcess::ReturnSynchEventToPool(mCommandCompleteEvent);
-            mCommandCompleteEvent = nullptr;
-            delete mThread;
-            mThread = nullptr;
+            mThreadPool->Destroy();
+            delete mThreadPool;
+            mThreadPool = nullptr;
         }
     }
 
-    void Attach(FMOD::System *system, int32 fileBufferSize)
+    void Attach(FMOD::System *system, int32 fileBufferSize, bool asyncRead)
     {
-        check(mThread);
+        check(mReferenceCount > 0);
 
-        verifyfmod(system->setFileSystem(OpenCallback, CloseCallback, ReadCallback, SeekCallback, 0, 0, fileBufferSize));
+        // Async reads need the pool threads to service the queue
+        if (asyncRead && mThreadPool)
+        {
+            verifyfmod(system->setFileSystem(OpenCallback, CloseCallback, nullptr, nullptr, AsyncReadCallback, AsyncCancelCallback, fileBufferSize));
+        }
+        else
+        {
+            verifyfmod(system->setFileSystem(OpenCallback, CloseCallback, ReadCallback, SeekCallback, 0, 0, fileBufferSize));
+        }
     }
 
-    uint32 Run() override
+private:
+    // State for a single open file. Each handle is serialized on its own lock, so different files never wait on each other.
+    struct FFileHandle
     {
-        bool stopRequested = false;
+        FFileHandle(FArchive *InArchive)
+            : Archive(InArchive)
+        {
+        }
+
+        FArchive *Archive;
+        FCriticalSection Crit;
+    };
 
-        while (!stopRequested)
+    // A single file operation, run on one of the pool threads while the calling FMOD thread waits for it.
+    class FFileCommand : public IQueuedWork
+    {
+    public:
+        FFileCommand(TFunctionRef<FMOD_RESULT()> InWork)
+            : Work(InWork)
+            , Result(FMOD_OK)
+            , CompleteEvent(FGenericPlatformProcess::GetSynchEventFromPool())
         {
-            mCommandReadyEvent->Wait();
+        }
 
-            switch (mCommand)
-            {
-                case COMMAND_OPEN:
-                    mResult = OpenInternal(mName, mFileSize, mHandleOut);
-                    break;
-                case COMMAND_CLOSE:
-                    mResult = CloseInternal(mHandleIn);
-                    break;
-                case COMMAND_READ:
-                    mResult = ReadInternal(mHandleIn, mBuffer, mSizeBytes, mBytesRead);
-                    break;
-                case COMMAND_SEEK:
-                    mResult = SeekInternal(mHandleIn, mSeekPosition);
-                    break;
-                case COMMAND_STOP:
-                    stopRequested = true;
-                    mResult = FMOD_OK;
-                    break;
-            }
+        ~FFileCommand() { FGenericPlatformProcess::ReturnSynchEventToPool(CompleteEvent); }
 
-            mCommandCompleteEvent->Trigger();
+        virtual void DoThreadedWork() override
+        {
+            Result = Work();
+            CompleteEvent->Trigger();
         }
 
-        return 0;
-    }
+        virtual void Abandon() override
+        {
+            Result = FMOD_ERR_FILE_BAD;
+            CompleteEvent->Trigger();
+        }
 
-private:
-    enum Command
-    {
-        COMMAND_OPEN,
-        COMMAND_CLOSE,
-        COMMAND_READ,
-        COMMAND_SEEK,
-        COMMAND_STOP,
-        COMMAND_MAX,
+        TFunctionRef<FMOD_RESULT()> Work;
+        FMOD_RESULT Result;
+        FEvent *CompleteEvent;
     };
 
-    FMOD_RESULT RunCommand(Command command)
+    FMOD_RESULT RunCommand(TFunctionRef<FMOD_RESULT()> Work)
     {
-        check(mThread);
+        // With no pool threads the file access happens directly on the FMOD thread that asked for it
+        if (!mThreadPool)
+        {
+            return Work();
+        }
 
-        mCommand = command;
-        mCommandReadyEvent->Trigger();
-        mCommandCompleteEvent->Wait();
+        FFileCommand Command(Work);
+        mThreadPool->AddQueuedWork(&Command);
+        Command.CompleteEvent->Wait();
 
-        return mResult;
+        return Command.Result;
     }
 
-    // Parameter for Close, Seek and Read
-    void *mHandleIn;
-
-    // Parameters for Open
-    const char *mName;
-    unsigned int *mFileSize;
-    void **mHandleOut;
-
-    // Parameters for Read
-    void *mBuffer;
-    unsigned int mSizeBytes;
-    unsigned int *mBytesRead;
-
-    // Parameter for Seek
-    unsigned int mSeekPosition;
+    // Services the highest priority outstanding async read. One of these is queued on the pool for every async read request.
+    class FAsyncReadCommand : public IQueuedWork
+    {
+    public:
+        virtual void DoThreadedWork() override;
+        virtual void Abandon() override;
+    };
 
-    Command mCommand;
-    FMOD_RESULT mResult;
+    void ServiceAsyncRead(FMOD_RESULT abandonResult);
 
     int mReferenceCount;
-    FRunnableThread *mThread;
-    FEvent *mCommandReadyEvent;
-    FEvent *mCommandCompleteEvent;
+    FQueuedThreadPool *mThreadPool;
 
+    // Outstanding async reads that have not been picked up by a pool thread yet, and the ones currently being read.
+    // An active read maps to the event a cancel is waiting on, or null if it hasn't been cancelled.
+    TArray<FMOD_ASYNCREADINFO *> mPendingReads;
+    TMap<FMOD_ASYNCREADINFO *, FEvent *> mActiveReads;
+    FCriticalSection mAsyncCrit;
+
+    // Only guards the reference count and pool lifetime, file operations never take it
     FCriticalSection mCrit;
 };
 
@@ -206,12 +196,7 @@ static FFMODFileSystem gFileSystem;
 
 FMOD_RESULT F_CALLBACK FFMODFileSystem::OpenCallback(const char *name, unsigned int *filesize, void **handle, void * /*userdata*/)
 {
-    FScopeLock lock(&gFileSystem.mCrit);
-    gFileSystem.mName = name;
-    gFileSystem.mFileSize = filesize;
-    gFileSystem.mHandleOut = handle;
-
-    return gFileSystem.RunCommand(COMMAND_OPEN);
+    return gFileSystem.RunCommand([=]() { return OpenInternal(name, filesize, handle); });
 }
 
 FMOD_RESULT FFMODFileSystem::OpenInternal(const char *name, unsigned int *filesize, void **handle)
@@ -225,7 +210,7 @@ FMOD_RESULT FFMODFileSystem::OpenInternal(const char *name, unsigned int *filesi
             return FMOD_ERR_FILE_NOTFOUND;
         }
         *filesize = Archive->TotalSize();
-        *handle = Archive;
+        *handle = new FFileHandle(Archive);
         UE_LOG(LogFMOD, Verbose, TEXT("  TotalSize = %d"), *filesize);
     }
 
@@ -234,10 +219,7 @@ FMOD_RESULT FFMODFileSystem::OpenInternal(const char *name, unsigned int *filesi
 
 FMOD_RESULT F_CALLBACK FFMODFileSystem::CloseCallback(void *handle, void * /*userdata*/)
 {
-    FScopeLock lock(&gFileSystem.mCrit);
-    gFileSystem.mHandleIn = handle;
-
-    return gFileSystem.RunCommand(COMMAND_CLOSE);
+    return gFileSystem.RunCommand([=]() { return CloseInternal(handle); });
 }
 
 FMOD_RESULT FFMODFileSystem::CloseInternal(void *handle)
@@ -247,22 +229,21 @@ FMOD_RESULT FFMODFileSystem::CloseInternal(void *handle)
         return FMOD_ERR_INVALID_PARAM;
     }
 
-    FArchive *Archive = (FArchive *)handle;
-    UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::CloseCallback closing archive %p"), Archive);
-    delete Archive;
+    FFileHandle *FileHandle = (FFileHandle *)handle;
+    UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::CloseCallback closing archive %p"), FileHandle->Archive);
+    {
+        FScopeLock lock(&FileHandle->Crit);
+        delete FileHandle->Archive;
+        FileHandle->Archive = nullptr;
+    }
+    delete FileHandle;
 
     return FMOD_OK;
 }
 
 FMOD_RESULT F_CALLBACK FFMODFileSystem::ReadCallback(void *handle, void *buffer, unsigned int sizebytes, unsigned int *bytesread, void * /*userdata*/)
 {
-    FScopeLock lock(&gFileSystem.mCrit);
-    gFileSystem.mHandleIn = handle;
-    gFileSystem.mBuffer = buffer;
-    gFileSystem.mSizeBytes = sizebytes;
-    gFileSystem.mBytesRead = bytesread;
-
-    return gFileSystem.RunCommand(COMMAND_READ);
+    return gFileSystem.RunCommand([=]() { return ReadInternal(handle, buffer, sizebytes, bytesread); });
 }
 
 FMOD_RESULT FFMODFileSystem::ReadInternal(void *handle, void *buffer, unsigned int sizebytes, unsigned int *bytesread)
@@ -274,7 +255,9 @@ FMOD_RESULT FFMODFileSystem::ReadInternal(void *handle, void *buffer, unsigned i
 
     if (bytesread)
     {
-        FArchive *Archive = (FArchive *)handle;
+        FFileHandle *FileHandle = (FFileHandle *)handle;
+        FScopeLock lock(&FileHandle->Crit);
+        FArchive *Archive = FileHandle->Archive;
 
         int64 BytesLeft = Archive->TotalSize() - Archive->Tell();
         int64 ReadAmount = FMath::Min((int64)sizebytes, BytesLeft);
@@ -293,11 +276,7 @@ FMOD_RESULT FFMODFileSystem::ReadInternal(void *handle, void *buffer, unsigned i
 
 FMOD_RESULT F_CALLBACK FFMODFileSystem::SeekCallback(void *handle, unsigned int pos, void * /*userdata*/)
 {
-    FScopeLock lock(&gFileSystem.mCrit);
-    gFileSystem.mHandleIn = handle;
-    gFileSystem.mSeekPosition = pos;
-
-    return gFileSystem.RunCommand(COMMAND_SEEK);
+    return gFileSystem.RunCommand([=]() { return SeekInternal(handle, pos); });
 }
 
 FMOD_RESULT FFMODFileSystem::SeekInternal(void *handle, unsigned int pos)
@@ -307,15 +286,142 @@ FMOD_RESULT FFMODFileSystem::SeekInternal(void *handle, unsigned int pos)
         return FMOD_ERR_INVALID_PARAM;
     }
 
-    FArchive *Archive = (FArchive *)handle;
-    Archive->Seek(pos);
+    FFileHandle *FileHandle = (FFileHandle *)handle;
+    FScopeLock lock(&FileHandle->Crit);
+    FileHandle->Archive->Seek(pos);
+
+    return FMOD_OK;
+}
+
+FMOD_RESULT F_CALLBACK FFMODFileSystem::AsyncReadCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/)
+{
+    {
+        FScopeLock lock(&gFileSystem.mAsyncCrit);
+        gFileSystem.mPendingReads.Add(info);
+    }
+    gFileSystem.mThreadPool->AddQueuedWork(new FAsyncReadCommand);
+
+    return FMOD_OK;
+}
+
+FMOD_RESULT F_CALLBACK FFMODFileSystem::AsyncCancelCallback(FMOD_ASYNCREADINFO *info, void * /*userdata*/)
+{
+    bool bWasPending = false;
+    {
+        FScopeLock lock(&gFileSystem.mAsyncCrit);
+        bWasPending = (gFileSystem.mPendingReads.Remove(info) > 0);
+    }
+
+    if (bWasPending)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT("FFMODFileSystem::AsyncCancelCallback cancelled pending read of %u bytes"), info->sizebytes);
+        info->done(info, FMOD_ERR_FILE_DISKEJECTED);
+        return FMOD_ERR_FILE_DISKEJECTED;
+    }
+
+    // The read is in progress on a pool thread, FMOD requires us to wait for it before returning
+    FEvent *CompleteEvent = nullptr;
+    {
+        FScopeLock lock(&gFileSystem.mAsyncCrit);
+        if (FEvent **ActiveEvent = gFileSystem.mActiveReads.Find(info))
+        {
+            CompleteEvent = FGenericPlatformProcess::GetSynchEventFromPool();
+            *ActiveEvent = CompleteEvent;
+        }
+    }
+
+    if (CompleteEvent)
+    {
+        CompleteEvent->Wait();
+        FGenericPlatformProcess::ReturnSynchEventToPool(CompleteEvent);
+    }
+
+    return FMOD_OK;
+}
+
+void FFMODFileSystem::FAsyncReadCommand::DoThreadedWork()
+{
+    gFileSystem.ServiceAsyncRead(FMOD_OK);
+    delete this;
+}
+
+void FFMODFileSystem::FAsyncReadCommand::Abandon()
+{
+    gFileSystem.ServiceAsyncRead(FMOD_ERR_FILE_DISKEJECTED);
+    delete this;
+}
+
+void FFMODFileSystem::ServiceAsyncRead(FMOD_RESULT abandonResult)
+{
+    FMOD_ASYNCREADINFO *info = nullptr;
+    {
+        FScopeLock lock(&mAsyncCrit);
+
+        // Pick the highest priority request, oldest first for equal priorities
+        int32 BestIndex = INDEX_NONE;
+        for (int32 i = 0; i < mPendingReads.Num(); ++i)
+        {
+            if (BestIndex == INDEX_NONE || mPendingReads[i]->priority > mPendingReads[BestIndex]->priority)
+            {
+                BestIndex = i;
+            }
+        }
+
+        if (BestIndex == INDEX_NONE)
+        {
+            // Request was cancelled before we got to it
+            return;
+        }
+
+        info = mPendingReads[BestIndex];
+        mPendingReads.RemoveAt(BestIndex);
+        mActiveReads.Add(info, nullptr);
+    }
+
+    FMOD_RESULT Result = (abandonResult == FMOD_OK) ? AsyncReadInternal(info) : abandonResult;
+    info->done(info, Result);
+
+    FEvent *CancelEvent = nullptr;
+    {
+        FScopeLock lock(&mAsyncCrit);
+        mActiveReads.RemoveAndCopyValue(info, CancelEvent);
+    }
+
+    if (CancelEvent)
+    {
+        CancelEvent->Trigger();
+    }
+}
+
+FMOD_RESULT FFMODFileSystem::AsyncReadInternal(FMOD_ASYNCREADINFO *info)
+{
+    if (!info->handle)
+    {
+        return FMOD_ERR_INVALID_PARAM;
+    }
+
+    FFileHandle *FileHandle = (FFileHandle *)info->handle;
+    FScopeLock lock(&FileHandle->Crit);
+    FArchive *Archive = FileHandle->Archive;
+
+    int64 BytesLeft = FMath::Max<int64>(0, Archive->TotalSize() - (int64)info->offset);
+    int64 ReadAmount = FMath::Clamp((int64)info->sizebytes, (int64)0, BytesLeft);
+
+    Archive->Seek(info->offset);
+    Archive->Serialize(info->buffer, ReadAmount);
+    info->bytesread = (unsigned int)ReadAmount;
+    if (ReadAmount < (int64)info->sizebytes)
+    {
+        UE_LOG(LogFMOD, Verbose, TEXT(" -> EOF "));
+        return FMOD_ERR_FILE_EOF;
+    }
 
     return FMOD_OK;
 }
 
-void AcquireFMODFileSystem()
+void AcquireFMODFileSystem(FGenericPlatformTypes::int32 threadCount)
 {
-    gFileSystem.IncrementReferenceCount();
+    gFileSystem.IncrementReferenceCount(threadCount);
 }
 
 void ReleaseFMODFileSystem()
@@ -323,7 +429,7 @@ void ReleaseFMODFileSystem()
     gFileSystem.DecrementReferenceCount();
 }
 
-void AttachFMODFileSystem(FMOD::System *system, int32 fileBufferSize)
+void AttachFMODFileSystem(FMOD::System *system, int32 fileBufferSize, bool asyncRead)
 {
-    gFileSystem.Attach(system, fileBufferSize);
+    gFileSystem.Attach(system, fileBufferSize, asyncRead);
 }
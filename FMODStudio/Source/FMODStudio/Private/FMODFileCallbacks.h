@@ -7,6 +7,6 @@
 
 FMOD_RESULT F_CALLBACK FMODLogCallback(FMOD_DEBUG_FLAGS flags, const char *file, int line, const char *func, const char *message);
 
-void AcquireFMODFileSystem();
+void AcquireFMODFileSystem(FGenericPlatformTypes::int32 threadCount);
 void ReleaseFMODFileSystem();
-void AttachFMODFileSystem(FMOD::System *system, FGenericPlatformTypes::int32 fileBufferSize);
+void AttachFMODFileSystem(FMOD::System *system, FGenericPlatformTypes::int32 fileBufferSize, bool asyncRead);
@@ -0,0 +1,337 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2021.
+
+#include "FMODInteriorVolumes.h"
+#include "FMODAudioComponent.h"
+#include "FMODListener.h"
+#include "EngineUtils.h"
+#include "GameFramework/WorldSettings.h"
+#include "Sound/AudioVolume.h"
+#include "Algo/StableSort.h"
+#include "FMODStudioPrivatePCH.h"
+
+namespace FMODInteriorVolumes
+{
+    /** Size of a grid cell in world units */
+    static const float CellSize = 2048.0f;
+
+    /** Volumes overlapping more cells than this are checked for every location instead */
+    static const int64 MaxCellsPerVolume = 512;
+
+    void GetInteriorSettings(UWorld *World, AAudioVolume *Volume, FInteriorSettings *OutInteriorSettings)
+    {
+        // Read the settings every time, they may be changed at runtime
+        if (Volume)
+        {
+            *OutInteriorSettings = Volume->GetInteriorSettings();
+        }
+        else
+        {
+            *OutInteriorSettings = World->GetWorldSettings(true)->DefaultAmbientZoneSettings;
+        }
+    }
+}
+
+FFMODInteriorVolumeManager *FFMODInteriorVolumeManager::Instance = nullptr;
+
+FFMODInteriorVolumeManager &FFMODInteriorVolumeManager::Get()
+{
+    if (!Instance)
+    {
+        Instance = new FFMODInteriorVolumeManager();
+    }
+    return *Instance;
+}
+
+void FFMODInteriorVolumeManager::Shutdown()
+{
+    delete Instance;
+    Instance = nullptr;
+}
+
+FFMODInteriorVolumeManager::FFMODInteriorVolumeManager()
+{
+    PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddRaw(this, &FFMODInteriorVolumeManager::OnWorldPreActorTick);
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FFMODInteriorVolumeManager::OnLevelChanged);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FFMODInteriorVolumeManager::OnLevelChanged);
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FFMODInteriorVolumeManager::OnWorldCleanup);
+}
+
+FFMODInteriorVolumeManager::~FFMODInteriorVolumeManager()
+{
+    FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+
+    for (auto &Kvp : Worlds)
+    {
+        if (UWorld *World = Kvp.Key.Get())
+        {
+            World->RemoveOnActorSpawnedHandler(Kvp.Value.ActorSpawnedHandle);
+        }
+    }
+}
+
+uint32 FFMODInteriorVolumeManager::GetVolumeSetVersion(UWorld *World)
+{
+    return FindOrAddWorld(World).Version;
+}
+
+void FFMODInteriorVolumeManager::MarkVolumesChanged(UWorld *World)
+{
+    // Worlds which aren't tracked yet gather their volumes when first used
+    if (FWorldVolumes *WorldVolumes = Worlds.Find(World))
+    {
+        ++WorldVolumes->Version;
+    }
+}
+
+FFMODInteriorVolumeManager::FWorldVolumes &FFMODInteriorVolumeManager::FindOrAddWorld(UWorld *World)
+{
+    FWorldVolumes *WorldVolumes = Worlds.Find(World);
+    if (!WorldVolumes)
+    {
+        WorldVolumes = &Worlds.Add(World);
+        WorldVolumes->ActorSpawnedHandle =
+            World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FFMODInteriorVolumeManager::OnActorSpawned));
+    }
+    return *WorldVolumes;
+}
+
+FIntVector FFMODInteriorVolumeManager::GetCell(const FVector &Location) const
+{
+    using namespace FMODInteriorVolumes;
+    return FIntVector(
+        FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void FFMODInteriorVolumeManager::UpdateIndex(UWorld *World, FWorldVolumes &WorldVolumes)
+{
+    using namespace FMODInteriorVolumes;
+
+    if (WorldVolumes.bIndexBuilt && WorldVolumes.IndexVersion == WorldVolumes.Version)
+    {
+        return;
+    }
+
+    WorldVolumes.bIndexBuilt = true;
+    WorldVolumes.IndexVersion = WorldVolumes.Version;
+    WorldVolumes.Volumes.Reset();
+    WorldVolumes.Cells.Reset();
+    WorldVolumes.LargeVolumes.Reset();
+
+    TArray<AAudioVolume *> FoundVolumes;
+    for (TActorIterator<AAudioVolume> It(World); It; ++It)
+    {
+        FoundVolumes.Add(*It);
+    }
+
+    // Same order as the world's own list, so the first volume containing a location wins
+    Algo::StableSort(FoundVolumes, [](AAudioVolume *A, AAudioVolume *B) { return A->GetPriority() > B->GetPriority(); });
+
+    for (int32 Index = 0; Index < FoundVolumes.Num(); ++Index)
+    {
+        AAudioVolume *Volume = FoundVolumes[Index];
+        WorldVolumes.Volumes.Add(Volume);
+
+        const FBox Bounds = Volume->GetBounds().GetBox();
+        const FIntVector MinCell = GetCell(Bounds.Min);
+        const FIntVector MaxCell = GetCell(Bounds.Max);
+        const int64 NumCells =
+            int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) * int64(MaxCell.Z - MinCell.Z + 1);
+
+        if (NumCells > MaxCellsPerVolume)
+        {
+            WorldVolumes.LargeVolumes.Add(Index);
+            continue;
+        }
+
+        for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+        {
+            for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+            {
+                for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+                {
+                    WorldVolumes.Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(Index);
+                }
+            }
+        }
+    }
+}
+
+AAudioVolume *FFMODInteriorVolumeManager::ResolveVolume(const FWorldVolumes &WorldVolumes, const FVector &Location) const
+{
+    const TArray<int32> *CellVolumes = WorldVolumes.Cells.Find(GetCell(Location));
+    const TArray<int32> &LargeVolumes = WorldVolumes.LargeVolumes;
+    const int32 NumCellVolumes = CellVolumes ? CellVolumes->Num() : 0;
+
+    // Both lists are in priority order, merge them
+    int32 CellIndex = 0;
+    int32 LargeIndex = 0;
+    while (CellIndex < NumCellVolumes || LargeIndex < LargeVolumes.Num())
+    {
+        int32 Index;
+        if (LargeIndex >= LargeVolumes.Num() || (CellIndex < NumCellVolumes && (*CellVolumes)[CellIndex] < LargeVolumes[LargeIndex]))
+        {
+            Index = (*CellVolumes)[CellIndex++];
+        }
+        else
+        {
+            Index = LargeVolumes[LargeIndex++];
+        }
+
+        AAudioVolume *Volume = WorldVolumes.Volumes[Index].Get();
+        if (Volume && Volume->GetEnabled() && Volume->EncompassesPoint(Location))
+        {
+            return Volume;
+        }
+    }
+
+    return nullptr;
+}
+
+AAudioVolume *FFMODInteriorVolumeManager::FindListenerVolume(
+    UWorld *World, const FVector &Location, FFMODListenerVolumeCache &Cache, FInteriorSettings *OutInteriorSettings)
+{
+    FWorldVolumes &WorldVolumes = FindOrAddWorld(World);
+
+    if (Cache.bValid && Cache.World == World && Cache.VolumeSetVersion == WorldVolumes.Version &&
+        FVector::DistSquared(Location, Cache.QueryLocation) < FMath::Square(Cache.SafeRadius))
+    {
+        AAudioVolume *CachedVolume = Cache.Volume.Get();
+        if (!Cache.bInVolume || (CachedVolume && CachedVolume->GetEnabled() && CachedVolume->EncompassesPoint(Location)))
+        {
+            FMODInteriorVolumes::GetInteriorSettings(World, CachedVolume, OutInteriorSettings);
+            return CachedVolume;
+        }
+    }
+
+    UpdateIndex(World, WorldVolumes);
+    AAudioVolume *Volume = ResolveVolume(WorldVolumes, Location);
+    FMODInteriorVolumes::GetInteriorSettings(World, Volume, OutInteriorSettings);
+
+    // Only a volume of at least the same priority can replace the current one, the result stays valid until the
+    // listener may have reached the bounds of one of them. Disabled volumes count as well since they can be enabled at any time.
+    float SafeDistSq = MAX_flt;
+    for (const TWeakObjectPtr<AAudioVolume> &OtherPtr : WorldVolumes.Volumes)
+    {
+        AAudioVolume *Other = OtherPtr.Get();
+        if (!Other || Other == Volume || (Volume && Other->GetPriority() < Volume->GetPriority()))
+        {
+            continue;
+        }
+
+        SafeDistSq = FMath::Min(SafeDistSq, Other->GetBounds().GetBox().ComputeSquaredDistanceToPoint(Location));
+    }
+
+    Cache.bValid = true;
+    Cache.World = World;
+    Cache.Volume = Volume;
+    Cache.bInVolume = Volume != nullptr;
+    Cache.VolumeSetVersion = WorldVolumes.Version;
+    Cache.QueryLocation = Location;
+    Cache.SafeRadius = FMath::Sqrt(SafeDistSq);
+
+    return Volume;
+}
+
+void FFMODInteriorVolumeManager::ResolveComponent(FWorldVolumes &WorldVolumes, const FVector &Location, FComponentVolume &Result)
+{
+    Result.Volume = ResolveVolume(WorldVolumes, Location);
+    Result.Location = Location;
+    Result.ResolvedFrame = GFrameCounter;
+}
+
+AAudioVolume *FFMODInteriorVolumeManager::FindComponentVolume(UFMODAudioComponent *Component, const FVector &Location, FInteriorSettings *OutInteriorSettings)
+{
+    UWorld *World = Component->GetWorld();
+    FWorldVolumes &WorldVolumes = FindOrAddWorld(World);
+
+    // Only this frame's result is reused, volumes may be enabled or disabled at any time
+    FComponentVolume *Result = WorldVolumes.Components.Find(Component);
+    if (!Result || Result->ResolvedFrame != GFrameCounter || Result->Location != Location)
+    {
+        if (!Result)
+        {
+            Result = &WorldVolumes.Components.Add(Component);
+        }
+
+        UpdateIndex(World, WorldVolumes);
+        ResolveComponent(WorldVolumes, Location, *Result);
+    }
+
+    AAudioVolume *Volume = Result->Volume.Get();
+    FMODInteriorVolumes::GetInteriorSettings(World, Volume, OutInteriorSettings);
+    return Volume;
+}
+
+void FFMODInteriorVolumeManager::RemoveComponent(UFMODAudioComponent *Component)
+{
+    if (FWorldVolumes *WorldVolumes = Worlds.Find(Component->GetWorld()))
+    {
+        WorldVolumes->Components.Remove(Component);
+    }
+}
+
+void FFMODInteriorVolumeManager::OnWorldPreActorTick(UWorld *World, ELevelTick TickType, float DeltaSeconds)
+{
+    FWorldVolumes *WorldVolumes = Worlds.Find(World);
+    if (!WorldVolumes || WorldVolumes->Components.Num() == 0)
+    {
+        return;
+    }
+
+    UpdateIndex(World, *WorldVolumes);
+    const double CurrentTime = FApp::GetCurrentTime();
+
+    // Resolve every playing component in one pass before the components tick. The grid lookup is cheap, and resolving
+    // stationary components too keeps them in step with volumes being enabled or disabled.
+    for (auto It = WorldVolumes->Components.CreateIterator(); It; ++It)
+    {
+        UFMODAudioComponent *Component = It.Key().Get();
+        if (!Component || !Component->StudioInstance || !Component->GetOwner())
+        {
+            It.RemoveCurrent();
+            continue;
+        }
+
+        // Components throttled by the spatial update interval won't read a result this frame
+        if (CurrentTime < Component->GetNextSpatialUpdateTime())
+        {
+            continue;
+        }
+
+        ResolveComponent(*WorldVolumes, Component->GetOwner()->GetTransform().GetTranslation(), It.Value());
+    }
+}
+
+void FFMODInteriorVolumeManager::OnActorSpawned(AActor *Actor)
+{
+    if (Actor && Actor->IsA<AAudioVolume>())
+    {
+        MarkVolumesChanged(Actor->GetWorld());
+    }
+}
+
+void FFMODInteriorVolumeManager::OnLevelChanged(ULevel *Level, UWorld *World)
+{
+    MarkVolumesChanged(World);
+}
+
+void FFMODInteriorVolumeManager::OnWorldCleanup(UWorld *World, bool bSessionEnded, bool bCleanupResources)
+{
+    FWorldVolumes WorldVolumes;
+    if (Worlds.RemoveAndCopyValue(World, WorldVolumes))
+    {
+        World->RemoveOnActorSpawnedHandler(WorldVolumes.ActorSpawnedHandle);
+    }
+
+    // Also drop entries for worlds that have already gone away
+    for (auto It = Worlds.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
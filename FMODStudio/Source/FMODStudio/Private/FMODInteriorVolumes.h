@@ -0,0 +1,121 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2021.
+
+#pragma once
+
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/World.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+class AAudioVolume;
+class ULevel;
+class UFMODAudioComponent;
+struct FFMODListenerVolumeCache;
+struct FInteriorSettings;
+
+/**
+ * Resolves which audio volume listeners and audio components are in, using a grid of the volume bounds per world.
+ * Registered components are resolved together every frame before the world's actors tick, components then read
+ * their result instead of querying the world. Resolving every frame picks up volumes enabled or disabled at runtime.
+ * Components whose spatial update is throttled are skipped until their next update is due.
+ * The grid is rebuilt whenever an audio volume is spawned or a level is added to or removed from the world. Moving a
+ * volume or changing its priority at runtime is not detected, call MarkVolumesChanged afterwards.
+ */
+class FFMODInteriorVolumeManager
+{
+public:
+    static FFMODInteriorVolumeManager &Get();
+    static FFMODInteriorVolumeManager *GetIfCreated() { return Instance; }
+    static void Shutdown();
+
+    ~FFMODInteriorVolumeManager();
+
+    /** Current version of the world's set of audio volumes. */
+    uint32 GetVolumeSetVersion(UWorld *World);
+
+    /** Force the world's volumes to be gathered again and every cached result for the world to be redone. */
+    void MarkVolumesChanged(UWorld *World);
+
+    /**
+     * Equivalent to UWorld::GetAudioSettings for a listener. The volume is only resolved again once the listener leaves
+     * the cached volume, may have entered another volume which could take priority, or the world's volumes changed.
+     */
+    AAudioVolume *FindListenerVolume(UWorld *World, const FVector &Location, FFMODListenerVolumeCache &Cache, FInteriorSettings *OutInteriorSettings);
+
+    /**
+     * Equivalent to UWorld::GetAudioSettings for an audio component. Registers the component to be resolved every frame,
+     * the result of this frame's pass is returned if the component has not moved since it was resolved.
+     */
+    AAudioVolume *FindComponentVolume(UFMODAudioComponent *Component, const FVector &Location, FInteriorSettings *OutInteriorSettings);
+
+    /** Stop resolving the component every frame. */
+    void RemoveComponent(UFMODAudioComponent *Component);
+
+private:
+    FFMODInteriorVolumeManager();
+
+    struct FComponentVolume
+    {
+        TWeakObjectPtr<AAudioVolume> Volume;
+        FVector Location;
+        uint64 ResolvedFrame;
+
+        FComponentVolume()
+            : Location(ForceInit)
+            , ResolvedFrame(0)
+        {
+        }
+    };
+
+    struct FWorldVolumes
+    {
+        uint32 Version;
+        uint32 IndexVersion;
+        bool bIndexBuilt;
+        FDelegateHandle ActorSpawnedHandle;
+
+        /** Audio volumes sorted by priority, highest first */
+        TArray<TWeakObjectPtr<AAudioVolume>> Volumes;
+
+        /** Indices into Volumes (ascending) of the volumes overlapping each grid cell */
+        TMap<FIntVector, TArray<int32>> Cells;
+
+        /** Volumes covering too many cells to be added to them, checked for every location */
+        TArray<int32> LargeVolumes;
+
+        TMap<TWeakObjectPtr<UFMODAudioComponent>, FComponentVolume> Components;
+
+        FWorldVolumes()
+            : Version(0)
+            , IndexVersion(0)
+            , bIndexBuilt(false)
+        {
+        }
+    };
+
+    FWorldVolumes &FindOrAddWorld(UWorld *World);
+
+    /** Gather the world's audio volumes into the grid if they changed since it was built. */
+    void UpdateIndex(UWorld *World, FWorldVolumes &WorldVolumes);
+
+    /** Find the highest priority enabled volume containing the location. */
+    AAudioVolume *ResolveVolume(const FWorldVolumes &WorldVolumes, const FVector &Location) const;
+
+    void ResolveComponent(FWorldVolumes &WorldVolumes, const FVector &Location, FComponentVolume &Result);
+
+    FIntVector GetCell(const FVector &Location) const;
+
+    void OnWorldPreActorTick(UWorld *World, ELevelTick TickType, float DeltaSeconds);
+    void OnActorSpawned(AActor *Actor);
+    void OnLevelChanged(ULevel *Level, UWorld *World);
+    void OnWorldCleanup(UWorld *World, bool bSessionEnded, bool bCleanupResources);
+
+    TMap<TWeakObjectPtr<UWorld>, FWorldVolumes> Worlds;
+
+    FDelegateHandle PreActorTickHandle;
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle LevelRemovedHandle;
+    FDelegateHandle WorldCleanupHandle;
+
+    static FFMODInteriorVolumeManager *Instance;
+};
@@ -5,7 +5,9 @@
 #include "GenericPlatform/GenericPlatform.h"
 #include "UObject/Object.h"
 #include "Math/Vector.h"
+#include "UObject/WeakObjectPtr.h"
 
+class UWorld;
 struct FInteriorSettings;
 
 /** Struct encapsulating settings for interior areas. */
@@ -27,6 +29,31 @@ struct FFMODInteriorSettings
     FFMODInteriorSettings &operator=(FInteriorSettings Other);
 };
 
+/** The last audio volume query made for a listener, see FFMODInteriorVolumeManager::FindListenerVolume. */
+struct FFMODListenerVolumeCache
+{
+    TWeakObjectPtr<UWorld> World;
+    TWeakObjectPtr<class AAudioVolume> Volume;
+    uint32 VolumeSetVersion;
+    FVector QueryLocation;
+
+    /** How far the listener can move from QueryLocation before it may reach the bounds of a volume that could take priority */
+    float SafeRadius;
+
+    /** False if the listener was outside of all volumes (using the world settings) */
+    bool bInVolume;
+    bool bValid;
+
+    FFMODListenerVolumeCache()
+        : VolumeSetVersion(0)
+        , QueryLocation(ForceInit)
+        , SafeRadius(0.0f)
+        , bInVolume(false)
+        , bValid(false)
+    {
+    }
+};
+
 /** A direct copy of FListener (which doesn't have external linkage, unfortunately) **/
 struct FFMODListener
 {
@@ -48,6 +75,9 @@ struct FFMODListener
     float ExteriorVolumeInterp;
     float ExteriorLPFInterp;
 
+    /** Reused by SetListenerPosition instead of querying the world's audio volumes every update */
+    FFMODListenerVolumeCache VolumeCache;
+
     FVector GetUp() const { return Transform.GetUnitAxis(EAxis::Z); }
     FVector GetFront() const { return Transform.GetUnitAxis(EAxis::Y); }
     FVector GetRight() const { return Transform.GetUnitAxis(EAxis::X); }
@@ -0,0 +1,107 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2021.
+
+#include "FMODOcclusion.h"
+#include "FMODAudioComponent.h"
+#include "FMODSettings.h"
+#include "Engine/World.h"
+#include "Algo/Sort.h"
+#include "FMODStudioPrivatePCH.h"
+
+FFMODOcclusionManager *FFMODOcclusionManager::Instance = nullptr;
+
+FFMODOcclusionManager &FFMODOcclusionManager::Get()
+{
+    if (!Instance)
+    {
+        Instance = new FFMODOcclusionManager();
+    }
+    return *Instance;
+}
+
+void FFMODOcclusionManager::Shutdown()
+{
+    delete Instance;
+    Instance = nullptr;
+}
+
+FFMODOcclusionManager::FFMODOcclusionManager()
+{
+    PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FFMODOcclusionManager::OnWorldPostActorTick);
+}
+
+FFMODOcclusionManager::~FFMODOcclusionManager()
+{
+    FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+}
+
+void FFMODOcclusionManager::RequestTrace(
+    UFMODAudioComponent *Component, const FVector &Start, const FVector &End, ECollisionChannel Channel, const FCollisionQueryParams &Params)
+{
+    FRequest *Request = Requests.Find(Component);
+    if (!Request)
+    {
+        Request = &Requests.Add(Component);
+        Request->QueuedFrame = GFrameCounter;
+    }
+
+    Request->World = Component->GetWorld();
+    Request->Start = Start;
+    Request->End = End;
+    Request->Channel = Channel;
+    Request->Params = Params;
+}
+
+void FFMODOcclusionManager::CancelTrace(UFMODAudioComponent *Component)
+{
+    Requests.Remove(Component);
+}
+
+void FFMODOcclusionManager::OnWorldPostActorTick(UWorld *World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (Requests.Num() == 0)
+    {
+        return;
+    }
+
+    // Gather this world's requests, dropping any whose component has gone away
+    TArray<TPair<TWeakObjectPtr<UFMODAudioComponent>, FRequest *>> WorldRequests;
+    for (auto It = Requests.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid() || !It.Value().World.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+        else if (It.Value().World.Get() == World)
+        {
+            WorldRequests.Emplace(It.Key(), &It.Value());
+        }
+    }
+
+    const int32 Budget = GetDefault<UFMODSettings>()->MaxOcclusionTracesPerFrame;
+    if (Budget > 0 && WorldRequests.Num() > Budget)
+    {
+        // Longest waiting requests go first so nobody starves
+        Algo::Sort(WorldRequests, [](const TPair<TWeakObjectPtr<UFMODAudioComponent>, FRequest *> &A,
+                                     const TPair<TWeakObjectPtr<UFMODAudioComponent>, FRequest *> &B) {
+            return A.Value->QueuedFrame < B.Value->QueuedFrame;
+        });
+        WorldRequests.SetNum(Budget, false);
+    }
+
+    for (const TPair<TWeakObjectPtr<UFMODAudioComponent>, FRequest *> &Entry : WorldRequests)
+    {
+        TWeakObjectPtr<UFMODAudioComponent> WeakComponent = Entry.Key;
+        const FRequest &Request = *Entry.Value;
+
+        FTraceDelegate Delegate = FTraceDelegate::CreateLambda([WeakComponent](const FTraceHandle &Handle, FTraceDatum &Data) {
+            if (UFMODAudioComponent *Component = WeakComponent.Get())
+            {
+                Component->OnOcclusionTraceCompleted(Data.OutHits.Num() > 0);
+            }
+        });
+        World->AsyncLineTraceByChannel(
+            EAsyncTraceType::Test, Request.Start, Request.End, Request.Channel, Request.Params, FCollisionResponseParams::DefaultResponseParam, &Delegate);
+
+        Requests.Remove(WeakComponent);
+    }
+}
@@ -0,0 +1,53 @@
+// Copyright (c), Firelight Technologies Pty, Ltd. 2012-2021.
+
+#pragma once
+
+#include "CollisionQueryParams.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/EngineTypes.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UFMODAudioComponent;
+class UWorld;
+
+/**
+ * Batches occlusion traces for all FMOD audio components.
+ * Components queue a request, the requests are issued as async line traces after the world's actors have ticked
+ * (oldest first, up to a per-frame budget) and the results are handed back to the components on a later frame.
+ */
+class FFMODOcclusionManager
+{
+public:
+    static FFMODOcclusionManager &Get();
+    static FFMODOcclusionManager *GetIfCreated() { return Instance; }
+    static void Shutdown();
+
+    ~FFMODOcclusionManager();
+
+    /** Queue an occlusion trace for a component, replacing any request it already has queued. */
+    void RequestTrace(UFMODAudioComponent *Component, const FVector &Start, const FVector &End, ECollisionChannel Channel,
+        const FCollisionQueryParams &Params);
+
+    /** Drop any queued request for a component. */
+    void CancelTrace(UFMODAudioComponent *Component);
+
+private:
+    FFMODOcclusionManager();
+
+    void OnWorldPostActorTick(UWorld *World, ELevelTick TickType, float DeltaSeconds);
+
+    struct FRequest
+    {
+        TWeakObjectPtr<UWorld> World;
+        FVector Start;
+        FVector End;
+        ECollisionChannel Channel;
+        FCollisionQueryParams Params;
+        uint64 QueuedFrame;
+    };
+
+    TMap<TWeakObjectPtr<UFMODAudioComponent>, FRequest> Requests;
+    FDelegateHandle PostActorTickHandle;
+
+    static FFMODOcclusionManager *Instance;
+};
@@ -23,6 +23,7 @@ UFMODSettings::UFMODSettings(const FObjectInitializer &ObjectInitializer)
     ContentBrowserPrefix = TEXT("/Game/FMOD/");
     bLoadAllBanks = true;
     bLoadAllSampleData = false;
+    bMemoryMapBanks = false;
     bEnableLiveUpdate = true;
     bVol0Virtual = true;
     Vol0VirtualLevel = 0.0001f;
@@ -31,6 +32,8 @@ UFMODSettings::UFMODSettings(const FObjectInitializer &ObjectInitializer)
     DSPBufferLength = 0;
     DSPBufferCount = 0;
     FileBufferSize = 2048;
+    FileAccessThreadCount = 4;
+    bAsyncFileRead = false;
     StudioUpdatePeriod = 0;
     LiveUpdatePort = 9264;
     EditorLiveUpdatePort = 9265;
@@ -38,6 +41,13 @@ UFMODSettings::UFMODSettings(const FObjectInitializer &ObjectInitializer)
     bMatchHardwareSampleRate = true;
     bLockAllBuses = false;
     bEnableMemoryTracking = false;
+    MaxOcclusionTracesPerFrame = 64;
+    OcclusionUpdateInterval = 0.25f;
+    OcclusionUpdateDistance = 5000.0f;
+    SpatialUpdateInterval = 0.0f;
+    SpatialUpdateDistance = 10000.0f;
+    AudioComponentPoolSize = 0;
+    EventInstancePoolSize = 0;
 }
 
 FString UFMODSettings::GetFullBankPath() const
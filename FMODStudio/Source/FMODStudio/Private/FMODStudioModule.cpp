@@ -9,9 +9,15 @@
 #include "FMODUtils.h"
 #include "FMODEvent.h"
 #include "FMODListener.h"
+#include "FMODAudioComponentPool.h"
+#include "FMODEventInstancePool.h"
+#include "FMODOcclusion.h"
+#include "FMODInteriorVolumes.h"
 #include "FMODSnapshotReverb.h"
 
 #include "Async/Async.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Async/MappedFileHandle.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/App.h"
 #include "Misc/CommandLine.h"
@@ -52,6 +58,12 @@ DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Current"), STAT_FMOD_Current_Memory, STA
 DECLARE_MEMORY_STAT(TEXT("FMOD Memory - Max"), STAT_FMOD_Max_Memory, STATGROUP_FMOD);
 DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Channels - Total"), STAT_FMOD_Total_Channels, STATGROUP_FMOD);
 DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Channels - Real"), STAT_FMOD_Real_Channels, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Component Pool - Hits"), STAT_FMOD_ComponentPool_Hits, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Component Pool - Misses"), STAT_FMOD_ComponentPool_Misses, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Component Pool - Evictions"), STAT_FMOD_ComponentPool_Evictions, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Instance Pool - Hits"), STAT_FMOD_InstancePool_Hits, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Instance Pool - Misses"), STAT_FMOD_InstancePool_Misses, STATGROUP_FMOD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("FMOD Instance Pool - Overflows"), STAT_FMOD_InstancePool_Overflows, STATGROUP_FMOD);
 
 const TCHAR *FMODSystemContextNames[EFMODSystemContext::Max] = {
     TEXT("Auditioning"), TEXT("Runtime"), TEXT("Editor"),
@@ -70,11 +82,32 @@ void F_CALLBACK FMODMemoryFree(void *ptr, FMOD_MEMORY_TYPE type, const char *sou
     FMemory::Free(ptr);
 }
 
+struct FFMODMappedBank
+{
+    FFMODMappedBank(IMappedFileHandle *InHandle, IMappedFileRegion *InRegion)
+        : Handle(InHandle)
+        , Region(InRegion)
+    {
+    }
+
+    ~FFMODMappedBank()
+    {
+        // The region must be released before the file handle it was mapped from
+        delete Region;
+        delete Handle;
+    }
+
+    IMappedFileHandle *Handle;
+    IMappedFileRegion *Region;
+};
+
 struct FFMODSnapshotEntry
 {
     FFMODSnapshotEntry(UFMODSnapshotReverb *InSnapshot = nullptr, FMOD::Studio::EventInstance *InInstance = nullptr)
         : Snapshot(InSnapshot)
         , Instance(InInstance)
+        , bHasIntensityID(false)
+        , AppliedIntensity(0.0f)
         , StartTime(0.0)
         , FadeDuration(0.0f)
         , FadeIntensityStart(0.0f)
@@ -82,9 +115,39 @@ struct FFMODSnapshotEntry
     {
     }
 
-    float CurrentIntensity() const
+    /** Create and start the snapshot instance, resolving the Intensity parameter once. */
+    static FFMODSnapshotEntry Create(FMOD::Studio::System *System, UFMODSnapshotReverb *Snapshot)
+    {
+        FFMODSnapshotEntry Entry(Snapshot);
+
+        FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Snapshot->AssetGuid);
+        FMOD::Studio::EventDescription *EventDesc = nullptr;
+        System->getEventByID(&Guid, &EventDesc);
+        if (EventDesc)
+        {
+            FMOD_STUDIO_PARAMETER_DESCRIPTION IntensityDesc = {};
+            if (EventDesc->getParameterDescriptionByName("Intensity", &IntensityDesc) == FMOD_OK)
+            {
+                Entry.IntensityID = IntensityDesc.id;
+                Entry.bHasIntensityID = true;
+            }
+
+            EventDesc->createInstance(&Entry.Instance);
+            if (Entry.Instance)
+            {
+                if (Entry.bHasIntensityID)
+                {
+                    Entry.Instance->setParameterByID(Entry.IntensityID, 0.0f);
+                }
+                Entry.Instance->start();
+            }
+        }
+
+        return Entry;
+    }
+
+    float CurrentIntensity(double CurrentTime) const
     {
-        double CurrentTime = FApp::GetCurrentTime();
         if (StartTime + FadeDuration <= CurrentTime)
         {
             return FadeIntensityEnd;
@@ -96,18 +159,32 @@ struct FFMODSnapshotEntry
         }
     }
 
-    void FadeTo(float Target, float Duration)
+    void FadeTo(float Target, float Duration, double CurrentTime)
     {
-        float StartIntensity = CurrentIntensity();
+        float StartIntensity = CurrentIntensity(CurrentTime);
 
-        StartTime = FApp::GetCurrentTime();
+        StartTime = CurrentTime;
         FadeDuration = Duration;
         FadeIntensityStart = StartIntensity;
         FadeIntensityEnd = Target;
     }
 
+    /** Set the Intensity parameter if the intensity changed since it was last set. */
+    void ApplyIntensity(double CurrentTime)
+    {
+        const float Intensity = 100.0f * CurrentIntensity(CurrentTime);
+        if (Instance && bHasIntensityID && Intensity != AppliedIntensity)
+        {
+            Instance->setParameterByID(IntensityID, Intensity);
+            AppliedIntensity = Intensity;
+        }
+    }
+
     UFMODSnapshotReverb *Snapshot;
     FMOD::Studio::EventInstance *Instance;
+    FMOD_STUDIO_PARAMETER_ID IntensityID;
+    bool bHasIntensityID;
+    float AppliedIntensity;
     double StartTime;
     float FadeDuration;
     float FadeIntensityStart;
@@ -168,6 +245,7 @@ public:
         for (int i = 0; i < EFMODSystemContext::Max; ++i)
         {
             StudioSystem[i] = nullptr;
+            bEventDescriptionCacheStale[i] = false;
         }
     }
 
@@ -194,6 +272,7 @@ public:
     bool LoadLibraries();
 
     void LoadBanks(EFMODSystemContext::Type Type);
+    FMOD_RESULT LoadBank(EFMODSystemContext::Type Type, const FString &BankPath, FMOD_STUDIO_LOAD_BANK_FLAGS BankFlags, FMOD::Studio::Bank **Bank);
 
 #if WITH_EDITOR
     void ReloadBanks();
@@ -227,6 +306,8 @@ public:
 
     virtual UFMODAsset *FindAssetByName(const FString &Name) override;
     virtual UFMODEvent *FindEventByName(const FString &Name) override;
+    virtual void FindAssetByNameAsync(const FString &Name, const FOnFMODAssetFound &OnFound) override;
+    virtual void PrefetchAssetsByName(const TArray<FString> &Names) override;
     virtual FString GetBankPath(const UFMODBank &Bank) override;
     virtual void GetAllBankPaths(TArray<FString> &Paths, bool IncludeMasterBank) const override;
 
@@ -256,6 +337,15 @@ public:
 
     void ResetInterpolation();
 
+    void InvalidateEventDescriptionCache(EFMODSystemContext::Type Type);
+
+    /** Studio system callback owned by the plugin, the system's user data is left free for the game */
+    static FMOD_RESULT F_CALLBACK StudioSystemCallback(
+        FMOD_STUDIO_SYSTEM *system, FMOD_STUDIO_SYSTEM_CALLBACK_TYPE type, void *commanddata, void *userdata);
+
+    /** The loaded module, used to find which context a Studio system callback came from */
+    static FFMODStudioModule *CallbackModule;
+
 #if PLATFORM_IOS || PLATFORM_TVOS
     void InitializeAudioSession();
     void ActivateAudioSession();
@@ -277,9 +367,18 @@ public:
     /** Table of assets with name and guid */
     FFMODAssetTable AssetTable;
 
+    /** Event descriptions already looked up by guid, per system */
+    TMap<FGuid, FMOD::Studio::EventDescription *> EventDescriptionCache[EFMODSystemContext::Max];
+
+    /** Set from the Studio update thread when a bank is unloaded, the matching cache is dropped on next lookup */
+    std::atomic<bool> bEventDescriptionCacheStale[EFMODSystemContext::Max];
+
     /** List of failed bank files */
     TArray<FString> FailedBankLoads[EFMODSystemContext::Max];
 
+    /** Bank files mapped into memory and read in place by FMOD, kept alive until the owning system is released */
+    TArray<TUniquePtr<FFMODMappedBank>> MappedBanks[EFMODSystemContext::Max];
+
     /** List of required plugins we found when loading banks. */
     TArray<FString> RequiredPlugins;
 
@@ -328,6 +427,27 @@ public:
 
 IMPLEMENT_MODULE(FFMODStudioModule, FMODStudio)
 
+FFMODStudioModule *FFMODStudioModule::CallbackModule = nullptr;
+
+FMOD_RESULT F_CALLBACK FFMODStudioModule::StudioSystemCallback(
+    FMOD_STUDIO_SYSTEM *system, FMOD_STUDIO_SYSTEM_CALLBACK_TYPE type, void *commanddata, void *userdata)
+{
+    FFMODStudioModule *Module = CallbackModule;
+    if (type == FMOD_STUDIO_SYSTEM_CALLBACK_BANK_UNLOAD && Module)
+    {
+        for (int i = 0; i < EFMODSystemContext::Max; ++i)
+        {
+            if ((FMOD_STUDIO_SYSTEM *)Module->StudioSystem[i] == system)
+            {
+                // Called from the Studio update thread, just flag the event description cache so the game thread drops it
+                Module->bEventDescriptionCacheStale[i].store(true);
+                break;
+            }
+        }
+    }
+    return FMOD_OK;
+}
+
 void FFMODStudioModule::LogError(int result, const char *function)
 {
     FString ErrorStr(ANSI_TO_TCHAR(FMOD_ErrorString((FMOD_RESULT)result)));
@@ -461,6 +581,7 @@ bool FFMODStudioModule::LoadLibraries()
 void FFMODStudioModule::StartupModule()
 {
     UE_LOG(LogFMOD, Log, TEXT("FFMODStudioModule startup"));
+    CallbackModule = this;
     BaseLibPath = IPluginManager::Get().FindPlugin(TEXT("FMODStudio"))->GetBaseDir() + TEXT("/Binaries");
     UE_LOG(LogFMOD, Log, TEXT("Lib path = '%s'"), *BaseLibPath);
 
@@ -503,7 +624,7 @@ void FFMODStudioModule::StartupModule()
         verifyfmod(FMODPlatformSystemSetup());
 #endif
 
-        AcquireFMODFileSystem();
+        AcquireFMODFileSystem(Settings.FileAccessThreadCount);
 
         RefreshSettings();
 
@@ -576,6 +697,7 @@ void FFMODStudioModule::CreateStudioSystem(EFMODSystemContext::Type Type)
     }
 
     verifyfmod(FMOD::Studio::System::create(&StudioSystem[Type]));
+    verifyfmod(StudioSystem[Type]->setCallback(StudioSystemCallback, FMOD_STUDIO_SYSTEM_CALLBACK_BANK_UNLOAD));
     FMOD::System *lowLevelSystem = nullptr;
     verifyfmod(StudioSystem[Type]->getCoreSystem(&lowLevelSystem));
 
@@ -626,7 +748,7 @@ void FFMODStudioModule::CreateStudioSystem(EFMODSystemContext::Type Type)
 
     verifyfmod(lowLevelSystem->setSoftwareFormat(SampleRate, OutputMode, 0));
     verifyfmod(lowLevelSystem->setSoftwareChannels(Settings.RealChannelCount));
-    AttachFMODFileSystem(lowLevelSystem, Settings.FileBufferSize);
+    AttachFMODFileSystem(lowLevelSystem, Settings.FileBufferSize, Settings.bAsyncFileRead);
 
     if (Settings.DSPBufferLength > 0 && Settings.DSPBufferCount > 0)
     {
@@ -778,6 +900,9 @@ void FFMODStudioModule::DestroyStudioSystem(EFMODSystemContext::Type Type)
         verifyfmod(StudioSystem[Type]->release());
         StudioSystem[Type] = nullptr;
     }
+
+    InvalidateEventDescriptionCache(Type);
+    MappedBanks[Type].Reset();
 }
 
 bool FFMODStudioModule::Tick(float DeltaTime)
@@ -806,6 +931,22 @@ bool FFMODStudioModule::Tick(float DeltaTime)
         SET_DWORD_STAT(STAT_FMOD_Real_Channels, realChannels);
         SET_DWORD_STAT(STAT_FMOD_Total_Channels, channels);
 
+        if (FFMODAudioComponentPool *ComponentPool = FFMODAudioComponentPool::GetIfCreated())
+        {
+            const FFMODAudioComponentPoolStats &PoolStats = ComponentPool->GetStats();
+            SET_DWORD_STAT(STAT_FMOD_ComponentPool_Hits, PoolStats.Hits);
+            SET_DWORD_STAT(STAT_FMOD_ComponentPool_Misses, PoolStats.Misses);
+            SET_DWORD_STAT(STAT_FMOD_ComponentPool_Evictions, PoolStats.Evictions);
+        }
+
+        if (FFMODEventInstancePool *EventInstancePool = FFMODEventInstancePool::GetIfCreated())
+        {
+            const FFMODEventInstancePoolStats &PoolStats = EventInstancePool->GetStats();
+            SET_DWORD_STAT(STAT_FMOD_InstancePool_Hits, PoolStats.Hits);
+            SET_DWORD_STAT(STAT_FMOD_InstancePool_Misses, PoolStats.Misses);
+            SET_DWORD_STAT(STAT_FMOD_InstancePool_Overflows, PoolStats.Overflows);
+        }
+
         verifyfmod(ClockSinks[EFMODSystemContext::Runtime]->LastResult);
     }
     if (ClockSinks[EFMODSystemContext::Editor].IsValid())
@@ -935,7 +1076,8 @@ void FFMODStudioModule::SetListenerPosition(int ListenerIndex, UWorld *World, co
 
         FInteriorSettings *InteriorSettings =
             (FInteriorSettings *)alloca(sizeof(FInteriorSettings)); // FinteriorSetting::FInteriorSettings() isn't exposed (possible UE4 bug???)
-        AAudioVolume *Volume = World->GetAudioSettings(ListenerPos, NULL, InteriorSettings);
+        AAudioVolume *Volume =
+            FFMODInteriorVolumeManager::Get().FindListenerVolume(World, ListenerPos, Listeners[ListenerIndex].VolumeCache, InteriorSettings);
 
         Listeners[ListenerIndex].Velocity =
             DeltaSeconds > 0.f ? (ListenerTransform.GetTranslation() - Listeners[ListenerIndex].Transform.GetTranslation()) / DeltaSeconds :
@@ -998,19 +1140,16 @@ void FFMODStudioModule::FinishSetListenerPosition(int NumListeners)
         NewSnapshot = Cast<UFMODSnapshotReverb>(BestVolume->GetReverbSettings().ReverbEffect);
     }
 
+    const double CurrentTime = FApp::GetCurrentTime();
+
     if (NewSnapshot != nullptr)
     {
-        FString NewSnapshotName = FMODUtils::LookupNameFromGuid(System, NewSnapshot->AssetGuid);
-        UE_LOG(LogFMOD, Verbose, TEXT("Starting new snapshot '%s'"), *NewSnapshotName);
-
         // Try to steal old entry
-        FFMODSnapshotEntry SnapshotEntry;
         int SnapshotEntryIndex = -1;
         for (int i = 0; i < ReverbSnapshots.Num(); ++i)
         {
             if (ReverbSnapshots[i].Snapshot == NewSnapshot)
             {
-                UE_LOG(LogFMOD, Verbose, TEXT("Re-using old entry with intensity %f"), ReverbSnapshots[i].CurrentIntensity());
                 SnapshotEntryIndex = i;
                 break;
             }
@@ -1018,52 +1157,43 @@ void FFMODStudioModule::FinishSetListenerPosition(int NumListeners)
         // Create new instance
         if (SnapshotEntryIndex == -1)
         {
-            UE_LOG(LogFMOD, Verbose, TEXT("Creating new instance"));
-
-            FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(NewSnapshot->AssetGuid);
-            FMOD::Studio::EventInstance *NewInstance = nullptr;
-            FMOD::Studio::EventDescription *EventDesc = nullptr;
-            System->getEventByID(&Guid, &EventDesc);
-            if (EventDesc)
-            {
-                EventDesc->createInstance(&NewInstance);
-                if (NewInstance)
-                {
-                    NewInstance->setParameterByName("Intensity", 0.0f);
-                    NewInstance->start();
-                }
-            }
+            UE_LOG(LogFMOD, Verbose, TEXT("Starting new snapshot '%s'"), *FMODUtils::LookupNameFromGuid(System, NewSnapshot->AssetGuid));
 
             SnapshotEntryIndex = ReverbSnapshots.Num();
-            ReverbSnapshots.Push(FFMODSnapshotEntry(NewSnapshot, NewInstance));
+            ReverbSnapshots.Push(FFMODSnapshotEntry::Create(System, NewSnapshot));
         }
         // Fade up
         if (ReverbSnapshots[SnapshotEntryIndex].FadeIntensityEnd == 0.0f)
         {
-            ReverbSnapshots[SnapshotEntryIndex].FadeTo(BestVolume->GetReverbSettings().Volume, BestVolume->GetReverbSettings().FadeTime);
+            UE_LOG(LogFMOD, Verbose, TEXT("Fading in snapshot from intensity %f"), ReverbSnapshots[SnapshotEntryIndex].CurrentIntensity(CurrentTime));
+            ReverbSnapshots[SnapshotEntryIndex].FadeTo(
+                BestVolume->GetReverbSettings().Volume, BestVolume->GetReverbSettings().FadeTime, CurrentTime);
         }
     }
     // Fade out all other entries
     for (int i = 0; i < ReverbSnapshots.Num(); ++i)
     {
-        UE_LOG(LogFMOD, Verbose, TEXT("Ramping intensity (%f,%f) -> %f"), ReverbSnapshots[i].FadeIntensityStart, ReverbSnapshots[i].FadeIntensityEnd,
-            ReverbSnapshots[i].CurrentIntensity());
-        ReverbSnapshots[i].Instance->setParameterByName("Intensity", 100.0f * ReverbSnapshots[i].CurrentIntensity());
+        FFMODSnapshotEntry &Entry = ReverbSnapshots[i];
+        Entry.ApplyIntensity(CurrentTime);
 
-        if (ReverbSnapshots[i].Snapshot != NewSnapshot)
+        if (Entry.Snapshot != NewSnapshot)
         {
             // Start fading out if needed
-            if (ReverbSnapshots[i].FadeIntensityEnd != 0.0f)
+            if (Entry.FadeIntensityEnd != 0.0f)
             {
-                ReverbSnapshots[i].FadeTo(0.0f, ReverbSnapshots[i].FadeDuration);
+                UE_LOG(LogFMOD, Verbose, TEXT("Fading out snapshot from intensity %f"), Entry.CurrentIntensity(CurrentTime));
+                Entry.FadeTo(0.0f, Entry.FadeDuration, CurrentTime);
             }
             // Finish fading out and remove
-            else if (ReverbSnapshots[i].CurrentIntensity() == 0.0f)
+            else if (Entry.CurrentIntensity(CurrentTime) == 0.0f)
             {
                 UE_LOG(LogFMOD, Verbose, TEXT("Removing snapshot"));
 
-                ReverbSnapshots[i].Instance->stop(FMOD_STUDIO_STOP_ALLOWFADEOUT);
-                ReverbSnapshots[i].Instance->release();
+                if (Entry.Instance)
+                {
+                    Entry.Instance->stop(FMOD_STUDIO_STOP_ALLOWFADEOUT);
+                    Entry.Instance->release();
+                }
                 ReverbSnapshots.RemoveAt(i);
                 --i; // removed entry, redo current index for next one
             }
@@ -1071,6 +1201,21 @@ void FFMODStudioModule::FinishSetListenerPosition(int NumListeners)
     }
 }
 
+void FFMODStudioModule::InvalidateEventDescriptionCache(EFMODSystemContext::Type Type)
+{
+    EventDescriptionCache[Type].Reset();
+    bEventDescriptionCacheStale[Type] = false;
+
+    // Pooled one-shot instances are keyed on the runtime event descriptions
+    if (Type == EFMODSystemContext::Runtime)
+    {
+        if (FFMODEventInstancePool *EventInstancePool = FFMODEventInstancePool::GetIfCreated())
+        {
+            EventInstancePool->Reset();
+        }
+    }
+}
+
 void FFMODStudioModule::RefreshSettings()
 {
     AssetTable.Load();
@@ -1132,6 +1277,19 @@ UFMODEvent *FFMODStudioModule::FindEventByName(const FString &Name)
     return Cast<UFMODEvent>(Asset);
 }
 
+void FFMODStudioModule::FindAssetByNameAsync(const FString &Name, const FOnFMODAssetFound &OnFound)
+{
+    AssetTable.GetAssetByStudioPathAsync(Name, OnFound);
+}
+
+void FFMODStudioModule::PrefetchAssetsByName(const TArray<FString> &Names)
+{
+    for (const FString &Name : Names)
+    {
+        AssetTable.GetAssetByStudioPathAsync(Name, FOnFMODAssetFound());
+    }
+}
+
 FString FFMODStudioModule::GetBankPath(const UFMODBank &Bank)
 {
     FString BankPath = AssetTable.GetBankPath(Bank);
@@ -1182,11 +1340,17 @@ void FFMODStudioModule::SetSystemPaused(bool paused)
 void FFMODStudioModule::ShutdownModule()
 {
     UE_LOG(LogFMOD, Verbose, TEXT("FFMODStudioModule shutdown"));
+    CallbackModule = nullptr;
 
     DestroyStudioSystem(EFMODSystemContext::Auditioning);
     DestroyStudioSystem(EFMODSystemContext::Runtime);
     DestroyStudioSystem(EFMODSystemContext::Editor);
 
+    FFMODOcclusionManager::Shutdown();
+    FFMODAudioComponentPool::Shutdown();
+    FFMODEventInstancePool::Shutdown();
+    FFMODInteriorVolumeManager::Shutdown();
+
     if (StudioLibHandle && LowLevelLibHandle)
     {
         ReleaseFMODFileSystem();
@@ -1247,6 +1411,10 @@ bool FFMODStudioModule::SetLocale(const FString& LocaleName)
         if (Locale.LocaleName == LocaleName)
         {
             AssetTable.SetLocale(Locale.LocaleCode);
+            for (int i = 0; i < EFMODSystemContext::Max; ++i)
+            {
+                InvalidateEventDescriptionCache((EFMODSystemContext::Type)i);
+            }
             return true;
         }
     }
@@ -1289,6 +1457,8 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
     if (StudioSystem[Type] != nullptr && Settings.IsBankPathSet())
     {
         UE_LOG(LogFMOD, Verbose, TEXT("LoadBanks for context %s"), FMODSystemContextNames[Type]);
+        const double LoadStartTime = FPlatformTime::Seconds();
+        InvalidateEventDescriptionCache(Type);
 
         /*
             Queue up all banks to load asynchronously then wait at the end.
@@ -1313,7 +1483,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
         {
             FString MasterBankPath = Settings.GetFullBankPath() / AssetTable.GetMasterBankPath();
             UE_LOG(LogFMOD, Verbose, TEXT("Loading master bank: %s"), *MasterBankPath);
-            Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*MasterBankPath), BankFlags, &MasterBank);
+            Result = LoadBank(Type, MasterBankPath, BankFlags, &MasterBank);
             BankEntries.Add(NamedBankEntry(MasterBankPath, MasterBank, Result));
         }
 
@@ -1323,7 +1493,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
             FString MasterAssetsBankPath = Settings.GetFullBankPath() / AssetTable.GetMasterAssetsBankPath();
             if (FPaths::FileExists(MasterAssetsBankPath))
             {
-                Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*MasterAssetsBankPath), BankFlags, &MasterAssetsBank);
+                Result = LoadBank(Type, MasterAssetsBankPath, BankFlags, &MasterAssetsBank);
                 BankEntries.Add(NamedBankEntry(MasterAssetsBankPath, MasterAssetsBank, Result));
             }
         }
@@ -1337,7 +1507,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
                 FString StringsBankPath = Settings.GetFullBankPath() / AssetTable.GetMasterStringsBankPath();
                 UE_LOG(LogFMOD, Verbose, TEXT("Loading strings bank: %s"), *StringsBankPath);
                 FMOD::Studio::Bank *StringsBank = nullptr;
-                Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*StringsBankPath), BankFlags, &StringsBank);
+                Result = LoadBank(Type, StringsBankPath, BankFlags, &StringsBank);
                 BankEntries.Add(NamedBankEntry(StringsBankPath, StringsBank, Result));
             }
 
@@ -1357,7 +1527,7 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
                     UE_LOG(LogFMOD, Log, TEXT("Loading bank: %s"), *OtherFile);
 
                     FMOD::Studio::Bank *OtherBank;
-                    Result = StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*OtherFile), BankFlags, &OtherBank);
+                    Result = LoadBank(Type, OtherFile, BankFlags, &OtherBank);
                     BankEntries.Add(NamedBankEntry(OtherFile, OtherBank, Result));
                 }
             }
@@ -1416,11 +1586,48 @@ void FFMODStudioModule::LoadBanks(EFMODSystemContext::Type Type)
                 FailedBankLoads[Type].Add(FString::Printf(TEXT("%s (%s)"), *FPaths::GetBaseFilename(Entry.Name), *ErrorMessage));
             }
         }
+
+        int CurrentAlloc = 0, MaxAlloc = 0;
+        FMOD::Memory_GetStats(&CurrentAlloc, &MaxAlloc, false);
+        UE_LOG(LogFMOD, Verbose, TEXT("LoadBanks for context %s took %.2fms, %d banks memory mapped, FMOD memory current = %d max = %d"),
+            FMODSystemContextNames[Type], (FPlatformTime::Seconds() - LoadStartTime) * 1000.0, MappedBanks[Type].Num(), CurrentAlloc, MaxAlloc);
     }
 
     bBanksLoaded = true;
 }
 
+FMOD_RESULT FFMODStudioModule::LoadBank(EFMODSystemContext::Type Type, const FString &BankPath, FMOD_STUDIO_LOAD_BANK_FLAGS BankFlags, FMOD::Studio::Bank **Bank)
+{
+    const UFMODSettings &Settings = *GetDefault<UFMODSettings>();
+
+    if (Settings.bMemoryMapBanks)
+    {
+        IMappedFileHandle *MappedHandle = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*BankPath);
+        if (MappedHandle)
+        {
+            IMappedFileRegion *MappedRegion = MappedHandle->MapRegion();
+            // Mapped regions are page aligned, which satisfies FMOD_STUDIO_LOAD_MEMORY_ALIGNMENT
+            if (MappedRegion && MappedRegion->GetMappedSize() <= MAX_int32 &&
+                IsAligned(MappedRegion->GetMappedPtr(), FMOD_STUDIO_LOAD_MEMORY_ALIGNMENT))
+            {
+                FMOD_RESULT Result = StudioSystem[Type]->loadBankMemory((const char *)MappedRegion->GetMappedPtr(),
+                    (int)MappedRegion->GetMappedSize(), FMOD_STUDIO_LOAD_MEMORY_POINT, BankFlags, Bank);
+                if (Result == FMOD_OK)
+                {
+                    UE_LOG(LogFMOD, Verbose, TEXT("Memory mapped bank: %s"), *BankPath);
+                    MappedBanks[Type].Add(MakeUnique<FFMODMappedBank>(MappedHandle, MappedRegion));
+                    return Result;
+                }
+            }
+            delete MappedRegion;
+            delete MappedHandle;
+        }
+        UE_LOG(LogFMOD, Verbose, TEXT("Could not memory map bank, falling back to file loading: %s"), *BankPath);
+    }
+
+    return StudioSystem[Type]->loadBankFile(TCHAR_TO_UTF8(*BankPath), BankFlags, Bank);
+}
+
 #if WITH_EDITOR
 void FFMODStudioModule::ReloadBanks()
 {
@@ -1456,9 +1663,26 @@ FMOD::Studio::EventDescription *FFMODStudioModule::GetEventDescription(const UFM
     }
     if (StudioSystem[Context] != nullptr && IsValid(Event) && Event->AssetGuid.IsValid())
     {
+        if (bEventDescriptionCacheStale[Context])
+        {
+            InvalidateEventDescriptionCache(Context);
+        }
+
+        FMOD::Studio::EventDescription **CachedEventDesc = EventDescriptionCache[Context].Find(Event->AssetGuid);
+        if (CachedEventDesc)
+        {
+            return *CachedEventDesc;
+        }
+
         FMOD::Studio::ID Guid = FMODUtils::ConvertGuid(Event->AssetGuid);
         FMOD::Studio::EventDescription *EventDesc = nullptr;
         StudioSystem[Context]->getEventByID(&Guid, &EventDesc);
+
+        // Don't cache misses, the event may turn up when its bank is loaded
+        if (EventDesc)
+        {
+            EventDescriptionCache[Context].Add(Event->AssetGuid, EventDesc);
+        }
         return EventDesc;
     }
     return nullptr;
@@ -22,6 +22,9 @@ class AAudioVolume;
 struct FInteriorSettings;
 struct FFMODListener; // Currently only for private use, we don't export this type
 
+/** Called with the asset found by an asynchronous lookup, or null if there is no asset with that name. */
+DECLARE_DELEGATE_OneParam(FOnFMODAssetFound, UFMODAsset *);
+
 // Which FMOD Studio system to use
 namespace EFMODSystemContext
 {
@@ -64,6 +67,8 @@ public:
 
     /**
 	 * Get a pointer to the runtime studio system (only valid in-game or in PIE)
+	 * The plugin registers its own Studio system callback to notice bank unloads. Replacing it with setCallback leaves
+	 * stale event descriptions in the plugin's cache. The system's user data is not used by the plugin.
 	 */
     virtual FMOD::Studio::System *GetStudioSystem(EFMODSystemContext::Type Context) = 0;
 
@@ -92,6 +97,17 @@ public:
 	 */
     virtual UFMODEvent *FindEventByName(const FString &Name) = 0;
 
+    /**
+	 * Look up an asset given its name without blocking on its package load.
+	 * The delegate is called immediately if the asset is already resident, otherwise once its package has loaded.
+	 */
+    virtual void FindAssetByNameAsync(const FString &Name, const FOnFMODAssetFound &OnFound) = 0;
+
+    /**
+	 * Start loading the assets with the given names in the background so later lookups don't block.
+	 */
+    virtual void PrefetchAssetsByName(const TArray<FString> &Names) = 0;
+
     /**
       * Get the disk path for a Bank asset
       */